@@ -10,6 +10,23 @@ def configs_optimal_core():
         "astar_ipdb": [
             "--search",
             "astar(ipdb())"],
+        "astar_ipdb_evaluation_threads": [
+            "--search",
+            "astar(ipdb(),evaluation_threads=2)"],
+        # HDA*
+        "hdastar_blind": [
+            "--search",
+            "hdastar(blind(),threads=2)"],
+        "hdastar_ipdb": [
+            "--search",
+            "hdastar(ipdb(),threads=2)"],
+        "hdastar_blind_shared_registry": [
+            "--search",
+            "hdastar(blind(),threads=2,shared_registry=true)"],
+        # External A* (stores its files in the directory for temporary files)
+        "external_astar_blind": [
+            "--search",
+            "external_astar(blind())"],
         "bjolp": [
             "--evaluator",
             "lmc=landmark_cost_partitioning(lm_merged([lm_rhw(),lm_hm(m=1)]))",
@@ -18,6 +35,15 @@ def configs_optimal_core():
         "astar_lmcut": [
             "--search",
             "astar(lmcut())"],
+        "astar_lmcut_evaluation_threads": [
+            "--search",
+            "astar(lmcut(),evaluation_threads=2)"],
+        "astar_lmcut_tree_storage": [
+            "--search",
+            "astar(lmcut(),state_storage=tree)"],
+        "astar_lmcut_dictionary_storage": [
+            "--search",
+            "astar(lmcut(),state_storage=dictionary)"],
         "astar_hmax": [
             "--search",
             "astar(hmax())"],
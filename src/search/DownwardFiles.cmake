@@ -51,6 +51,8 @@ fast_downward_plugin(
         abstract_task
         axioms
         command_line
+        compressed_state_registry
+        concurrent_state_registry
         evaluation_context
         evaluation_result
         evaluator
@@ -122,6 +124,8 @@ fast_downward_plugin(
         utils/markup
         utils/math
         utils/memory
+        utils/memory_mapped_file
+        utils/parallel
         utils/rng
         utils/rng_options
         utils/strings
@@ -146,6 +150,13 @@ fast_downward_plugin(
         open_lists/best_first_open_list
 )
 
+fast_downward_plugin(
+    NAME BUCKET_OPEN_LIST
+    HELP "Open list with bucket arrays for one or two integer evaluators"
+    SOURCES
+        open_lists/bucket_open_list
+)
+
 fast_downward_plugin(
     NAME EPSILON_GREEDY_OPEN_LIST
     HELP "Open list that chooses an entry randomly with probability epsilon"
@@ -379,7 +390,7 @@ fast_downward_plugin(
     HELP "Basic classes used for all search engines"
     SOURCES
         search_engines/search_common
-    DEPENDS ALTERNATION_OPEN_LIST G_EVALUATOR BEST_FIRST_OPEN_LIST SUM_EVALUATOR TIEBREAKING_OPEN_LIST WEIGHTED_EVALUATOR
+    DEPENDS ALTERNATION_OPEN_LIST G_EVALUATOR BEST_FIRST_OPEN_LIST BUCKET_OPEN_LIST SUM_EVALUATOR TIEBREAKING_OPEN_LIST WEIGHTED_EVALUATOR
     DEPENDENCY_ONLY
 )
 
@@ -388,6 +399,7 @@ fast_downward_plugin(
     HELP "Eager search algorithm"
     SOURCES
         search_engines/eager_search
+        search_engines/parallel_successor_evaluator
     DEPENDS NULL_PRUNING_METHOD ORDERED_SET SUCCESSOR_GENERATOR
     DEPENDENCY_ONLY
 )
@@ -456,6 +468,22 @@ fast_downward_plugin(
     DEPENDS G_EVALUATOR ORDERED_SET PREF_EVALUATOR SEARCH_COMMON SUCCESSOR_GENERATOR
 )
 
+fast_downward_plugin(
+    NAME HDA_STAR_SEARCH
+    HELP "Hash-distributed parallel A* search"
+    SOURCES
+        search_engines/hda_star_search
+    DEPENDS SEARCH_COMMON SUCCESSOR_GENERATOR TASK_PROPERTIES
+)
+
+fast_downward_plugin(
+    NAME EXTERNAL_ASTAR_SEARCH
+    HELP "External A* search with delayed duplicate detection"
+    SOURCES
+        search_engines/external_astar_search
+    DEPENDS SUCCESSOR_GENERATOR TASK_PROPERTIES
+)
+
 fast_downward_plugin(
     NAME ITERATED_SEARCH
     HELP "Iterated search algorithm"
@@ -665,6 +693,7 @@ fast_downward_plugin(
     HELP "The Merge-and-Shrink heuristic"
     SOURCES
         merge_and_shrink/distances
+        merge_and_shrink/factor_cache
         merge_and_shrink/factored_transition_system
         merge_and_shrink/fts_factory
         merge_and_shrink/label_reduction
@@ -771,6 +800,7 @@ fast_downward_plugin(
         pdbs/pattern_generator_random
         pdbs/pattern_generator
         pdbs/pattern_information
+        pdbs/pdb_cache
         pdbs/pdb_heuristic
         pdbs/random_pattern
         pdbs/subcategory
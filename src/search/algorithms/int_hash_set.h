@@ -292,6 +292,25 @@ public:
         return insert(key, hasher(key));
     }
 
+    /*
+      Like insert(key), but use the given hash instead of computing it.
+      The hash must be the one that the hasher of this set computes for
+      the key.
+    */
+    std::pair<KeyType, bool> insert_with_hash(KeyType key, HashType hash) {
+        assert(key >= 0);
+        return insert(key, hash);
+    }
+
+    /*
+      Load the ideal bucket of the given hash into the processor cache.
+      Callers that insert several keys can prefetch the buckets of all
+      keys first to overlap the cache misses of the insertions.
+    */
+    void prefetch(HashType hash) const {
+        utils::prefetch(&buckets[get_bucket(hash)]);
+    }
+
     void dump(utils::LogProxy &log) const {
         int num_buckets = capacity();
         log << "[";
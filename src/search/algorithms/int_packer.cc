@@ -29,40 +29,19 @@ static int get_bit_size_for_range(int range) {
     return num_bits;
 }
 
-class IntPacker::VariableInfo {
-    int range;
-    int bin_index;
-    int shift;
-    Bin read_mask;
-    Bin clear_mask;
-public:
-    VariableInfo(int range_, int bin_index_, int shift_)
-        : range(range_),
-          bin_index(bin_index_),
-          shift(shift_) {
-        int bit_size = get_bit_size_for_range(range);
-        read_mask = get_bit_mask(shift, shift + bit_size);
-        clear_mask = ~read_mask;
-    }
-
-    VariableInfo()
-        : bin_index(-1), shift(0), read_mask(0), clear_mask(0) {
-        // Default constructor needed for resize() in pack_bins.
-    }
-
-    ~VariableInfo() {
-    }
-
-    int get(const Bin *buffer) const {
-        return (buffer[bin_index] & read_mask) >> shift;
-    }
+IntPacker::VariableInfo::VariableInfo(int range_, int bin_index_, int shift_)
+    : range(range_),
+      bin_index(bin_index_),
+      shift(shift_) {
+    int bit_size = get_bit_size_for_range(range);
+    read_mask = get_bit_mask(shift, shift + bit_size);
+    clear_mask = ~read_mask;
+}
 
-    void set(Bin *buffer, int value) const {
-        assert(value >= 0 && value < range);
-        Bin &bin = buffer[bin_index];
-        bin = (bin & clear_mask) | (value << shift);
-    }
-};
+IntPacker::VariableInfo::VariableInfo()
+    : bin_index(-1), shift(0), read_mask(0), clear_mask(0) {
+    // Default constructor needed for resize() in pack_bins.
+}
 
 
 IntPacker::IntPacker(const vector<int> &ranges)
@@ -73,14 +52,6 @@ IntPacker::IntPacker(const vector<int> &ranges)
 IntPacker::~IntPacker() {
 }
 
-int IntPacker::get(const Bin *buffer, int var) const {
-    return var_infos[var].get(buffer);
-}
-
-void IntPacker::set(Bin *buffer, int var, int value) const {
-    var_infos[var].set(buffer, value);
-}
-
 void IntPacker::pack_bins(const vector<int> &ranges) {
     assert(var_infos.empty());
 
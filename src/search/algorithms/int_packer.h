@@ -1,6 +1,7 @@
 #ifndef ALGORITHMS_INT_PACKER_H
 #define ALGORITHMS_INT_PACKER_H
 
+#include <cassert>
 #include <vector>
 
 /*
@@ -19,7 +20,35 @@
 */
 namespace int_packer {
 class IntPacker {
-    class VariableInfo;
+public:
+    typedef unsigned int Bin;
+
+private:
+    /*
+      The class is defined here (rather than in the .cc file) so that
+      get() and set() can be inlined. They are called for every variable
+      access of a packed state.
+    */
+    class VariableInfo {
+        int range;
+        int bin_index;
+        int shift;
+        Bin read_mask;
+        Bin clear_mask;
+    public:
+        VariableInfo(int range_, int bin_index_, int shift_);
+        VariableInfo();
+
+        int get(const Bin *buffer) const {
+            return (buffer[bin_index] & read_mask) >> shift;
+        }
+
+        void set(Bin *buffer, int value) const {
+            assert(value >= 0 && value < range);
+            Bin &bin = buffer[bin_index];
+            bin = (bin & clear_mask) | (value << shift);
+        }
+    };
 
     std::vector<VariableInfo> var_infos;
     int num_bins;
@@ -28,7 +57,6 @@ class IntPacker {
                      std::vector<std::vector<int>> &bits_to_vars);
     void pack_bins(const std::vector<int> &ranges);
 public:
-    typedef unsigned int Bin;
 
     /*
       The constructor takes the range for each variable. The domain of
@@ -39,8 +67,13 @@ public:
     explicit IntPacker(const std::vector<int> &ranges);
     ~IntPacker();
 
-    int get(const Bin *buffer, int var) const;
-    void set(Bin *buffer, int var, int value) const;
+    int get(const Bin *buffer, int var) const {
+        return var_infos[var].get(buffer);
+    }
+
+    void set(Bin *buffer, int var, int value) const {
+        var_infos[var].set(buffer, value);
+    }
 
     int get_num_bins() const {return num_bins;}
 };
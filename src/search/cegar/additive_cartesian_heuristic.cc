@@ -41,13 +41,19 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
 AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
     const plugins::Options &opts)
     : Heuristic(opts),
-      heuristic_functions(generate_heuristic_functions(opts, log)) {
+      heuristic_functions(
+          make_shared<const vector<CartesianHeuristicFunction>>(
+              generate_heuristic_functions(opts, log))) {
+}
+
+shared_ptr<Evaluator> AdditiveCartesianHeuristic::create_thread_copy() const {
+    return make_shared<AdditiveCartesianHeuristic>(*this);
 }
 
 int AdditiveCartesianHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     int sum_h = 0;
-    for (const CartesianHeuristicFunction &function : heuristic_functions) {
+    for (const CartesianHeuristicFunction &function : *heuristic_functions) {
         int value = function.get_value(state);
         assert(value >= 0);
         if (value == INF)
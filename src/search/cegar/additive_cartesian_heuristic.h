@@ -3,6 +3,7 @@
 
 #include "../heuristic.h"
 
+#include <memory>
 #include <vector>
 
 namespace cegar {
@@ -13,13 +14,17 @@ class CartesianHeuristicFunction;
   summing all of their values.
 */
 class AdditiveCartesianHeuristic : public Heuristic {
-    const std::vector<CartesianHeuristicFunction> heuristic_functions;
+    // Shared with the copies created by create_thread_copy.
+    const std::shared_ptr<const std::vector<CartesianHeuristicFunction>>
+    heuristic_functions;
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 
 public:
     explicit AdditiveCartesianHeuristic(const plugins::Options &opts);
+
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const override;
 };
 }
 
@@ -0,0 +1,299 @@
+#include "compressed_state_registry.h"
+
+#include "task_proxy.h"
+
+#include "plugins/plugin.h"
+#include "task_utils/task_properties.h"
+#include "utils/language.h"
+#include "utils/logging.h"
+#include "utils/memory.h"
+#include "utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+CompressedStateRegistry::RowTable::RowTable(int row_size)
+    : row_size(row_size),
+      rows(row_size),
+      row_ids(StateIDSemanticHash(rows, row_size),
+              StateIDSemanticEqual(rows, row_size)) {
+}
+
+pair<int, bool> CompressedStateRegistry::RowTable::insert(
+    const PackedStateBin *row) {
+    rows.push_back(row);
+    pair<int, bool> result = row_ids.insert(rows.size() - 1);
+    if (!result.second) {
+        rows.pop_back();
+    }
+    return result;
+}
+
+void CompressedStateRegistry::RowTable::print_statistics(
+    utils::LogProxy &log) const {
+    log << size() << " rows with " << row_size << " bin(s) each, "
+        << size() * row_size * sizeof(PackedStateBin) << " bytes" << endl;
+    row_ids.print_statistics(log);
+}
+
+
+CompressedStateRegistry::CompressedStateRegistry(
+    const TaskProxy &task_proxy, int compressed_size)
+    : StateRegistry(task_proxy),
+      compressed_states(utils::make_unique_ptr<RowTable>(compressed_size)),
+      successor_buffer(get_bins_per_state()) {
+}
+
+State CompressedStateRegistry::lookup_state(StateID id) const {
+    auto buffer = make_shared<vector<PackedStateBin>>(get_bins_per_state());
+    unpack((*compressed_states)[id.value], buffer->data());
+    return task_proxy.create_state(*this, id, move(buffer));
+}
+
+State CompressedStateRegistry::get_successor_state(
+    const State &predecessor, const OperatorProxy &op) {
+    compute_successor_buffer(predecessor, op, successor_buffer.data());
+    return insert_state(successor_buffer.data());
+}
+
+void CompressedStateRegistry::get_successor_states(
+    const State &predecessor, span<const OperatorID> operator_ids,
+    vector<State> &successors) {
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (OperatorID op_id : operator_ids) {
+        successors.push_back(
+            get_successor_state(predecessor, operators[op_id]));
+    }
+}
+
+State CompressedStateRegistry::insert_state(const PackedStateBin *buffer) {
+    const PackedStateBin *compressed = compress(buffer);
+    StateID id(compressed_states->insert(compressed).first);
+    num_states.store(compressed_states->size(), memory_order_relaxed);
+    // We already have the unpacked data, so there is no need to unpack.
+    auto owned_buffer = make_shared<vector<PackedStateBin>>(
+        buffer, buffer + get_bins_per_state());
+    return task_proxy.create_state(*this, id, move(owned_buffer));
+}
+
+void CompressedStateRegistry::print_statistics(utils::LogProxy &log) const {
+    log << "Number of registered states: " << size() << endl;
+    log << "Compressed states: ";
+    compressed_states->print_statistics(log);
+    print_compression_statistics(log);
+}
+
+void CompressedStateRegistry::change_compressed_size(
+    int new_size,
+    const function<void(const PackedStateBin *, PackedStateBin *)> &convert) {
+    auto new_states = utils::make_unique_ptr<RowTable>(new_size);
+    vector<PackedStateBin> row(new_size);
+    int num_rows = compressed_states->size();
+    for (int id = 0; id < num_rows; ++id) {
+        fill(row.begin(), row.end(), 0);
+        convert((*compressed_states)[id], row.data());
+        /*
+          Converting canonical representations must give canonical
+          representations, so no two rows can collapse here.
+        */
+        int new_id = new_states->insert(row.data()).first;
+        utils::unused_variable(new_id);
+        assert(new_id == id);
+    }
+    compressed_states = move(new_states);
+}
+
+
+static int get_num_state_bins(const TaskProxy &task_proxy) {
+    return task_properties::g_state_packers[task_proxy].get_num_bins();
+}
+
+static int get_num_index_bins(const vector<int> &index_ranges) {
+    return int_packer::IntPacker(index_ranges).get_num_bins();
+}
+
+static vector<int> get_initial_index_ranges(const TaskProxy &task_proxy) {
+    int num_bins = get_num_state_bins(task_proxy);
+    /*
+      Start with one bit per bin. (A range of 1 would need no bits at all,
+      but then the compressed representation could have no bins.)
+    */
+    return vector<int>(num_bins, 2);
+}
+
+DictionaryStateRegistry::DictionaryStateRegistry(const TaskProxy &task_proxy)
+    : CompressedStateRegistry(
+          task_proxy,
+          get_num_index_bins(get_initial_index_ranges(task_proxy))),
+      index_ranges(get_initial_index_ranges(task_proxy)),
+      index_packer(utils::make_unique_ptr<int_packer::IntPacker>(index_ranges)),
+      indices(index_ranges.size()),
+      compressed_buffer(index_packer->get_num_bins()),
+      num_conversions(0) {
+    for (size_t i = 0; i < index_ranges.size(); ++i) {
+        dictionaries.push_back(utils::make_unique_ptr<RowTable>(1));
+    }
+}
+
+DictionaryStateRegistry::~DictionaryStateRegistry() {
+}
+
+void DictionaryStateRegistry::grow_index_ranges() {
+    const int max_range = 1 << MAX_INDEX_BITS;
+    vector<int> new_ranges = index_ranges;
+    for (size_t i = 0; i < new_ranges.size(); ++i) {
+        while (dictionaries[i]->size() > new_ranges[i]) {
+            if (new_ranges[i] == max_range) {
+                cerr << "Too many distinct values of a state bin for "
+                     << "dictionary compression." << endl;
+                utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+            }
+            new_ranges[i] = min(
+                new_ranges[i] << INDEX_BITS_INCREMENT, max_range);
+        }
+    }
+
+    auto new_packer = utils::make_unique_ptr<int_packer::IntPacker>(new_ranges);
+    int num_vars = new_ranges.size();
+    change_compressed_size(
+        new_packer->get_num_bins(),
+        [&](const PackedStateBin *old_row, PackedStateBin *new_row) {
+            for (int var = 0; var < num_vars; ++var) {
+                new_packer->set(
+                    new_row, var, index_packer->get(old_row, var));
+            }
+        });
+    index_ranges = move(new_ranges);
+    index_packer = move(new_packer);
+    compressed_buffer.assign(index_packer->get_num_bins(), 0);
+    ++num_conversions;
+}
+
+const PackedStateBin *DictionaryStateRegistry::compress(
+    const PackedStateBin *buffer) {
+    int num_vars = indices.size();
+    bool needs_growth = false;
+    for (int var = 0; var < num_vars; ++var) {
+        indices[var] = dictionaries[var]->insert(&buffer[var]).first;
+        if (indices[var] >= index_ranges[var])
+            needs_growth = true;
+    }
+    if (needs_growth)
+        grow_index_ranges();
+    for (int var = 0; var < num_vars; ++var) {
+        index_packer->set(compressed_buffer.data(), var, indices[var]);
+    }
+    return compressed_buffer.data();
+}
+
+void DictionaryStateRegistry::unpack(
+    const PackedStateBin *compressed, PackedStateBin *buffer) const {
+    int num_vars = indices.size();
+    for (int var = 0; var < num_vars; ++var) {
+        buffer[var] = *(*dictionaries[var])[index_packer->get(compressed, var)];
+    }
+}
+
+void DictionaryStateRegistry::print_compression_statistics(
+    utils::LogProxy &log) const {
+    int num_values = 0;
+    for (const unique_ptr<RowTable> &dictionary : dictionaries) {
+        num_values += dictionary->size();
+    }
+    log << "Dictionary entries: " << num_values << endl;
+    log << "Bins per compressed state: " << index_packer->get_num_bins()
+        << " (instead of " << get_bins_per_state() << ")" << endl;
+    log << "Conversions of compressed states: " << num_conversions << endl;
+}
+
+
+TreeStateRegistry::TreeStateRegistry(const TaskProxy &task_proxy)
+    : CompressedStateRegistry(task_proxy, min(get_num_state_bins(task_proxy), 2)),
+      nodes(2),
+      num_bins(get_num_state_bins(task_proxy)),
+      compressed_buffer(min(num_bins, 2)) {
+}
+
+TreeStateRegistry::~TreeStateRegistry() {
+}
+
+PackedStateBin TreeStateRegistry::compress_bins(
+    const PackedStateBin *buffer, int size) {
+    if (size == 1)
+        return buffer[0];
+    int left_size = size / 2;
+    PackedStateBin node[2] = {
+        compress_bins(buffer, left_size),
+        compress_bins(buffer + left_size, size - left_size)
+    };
+    return nodes.insert(node).first;
+}
+
+void TreeStateRegistry::unpack_bins(
+    PackedStateBin compressed, int size, PackedStateBin *buffer) const {
+    if (size == 1) {
+        buffer[0] = compressed;
+        return;
+    }
+    int left_size = size / 2;
+    const PackedStateBin *node = nodes[compressed];
+    unpack_bins(node[0], left_size, buffer);
+    unpack_bins(node[1], size - left_size, buffer + left_size);
+}
+
+const PackedStateBin *TreeStateRegistry::compress(
+    const PackedStateBin *buffer) {
+    if (num_bins == 1) {
+        compressed_buffer[0] = buffer[0];
+    } else {
+        int left_size = num_bins / 2;
+        compressed_buffer[0] = compress_bins(buffer, left_size);
+        compressed_buffer[1] = compress_bins(
+            buffer + left_size, num_bins - left_size);
+    }
+    return compressed_buffer.data();
+}
+
+void TreeStateRegistry::unpack(
+    const PackedStateBin *compressed, PackedStateBin *buffer) const {
+    if (num_bins == 1) {
+        buffer[0] = compressed[0];
+    } else {
+        int left_size = num_bins / 2;
+        unpack_bins(compressed[0], left_size, buffer);
+        unpack_bins(compressed[1], num_bins - left_size, buffer + left_size);
+    }
+}
+
+void TreeStateRegistry::print_compression_statistics(
+    utils::LogProxy &log) const {
+    log << "Tree nodes: ";
+    nodes.print_statistics(log);
+}
+
+
+unique_ptr<StateRegistry> create_state_registry(
+    const TaskProxy &task_proxy, StateStorage storage) {
+    switch (storage) {
+    case StateStorage::PACKED:
+        return utils::make_unique_ptr<StateRegistry>(task_proxy);
+    case StateStorage::DICTIONARY:
+        return utils::make_unique_ptr<DictionaryStateRegistry>(task_proxy);
+    case StateStorage::TREE:
+        return utils::make_unique_ptr<TreeStateRegistry>(task_proxy);
+    default:
+        ABORT("Unknown state storage");
+    }
+}
+
+static plugins::TypedEnumPlugin<StateStorage> _enum_plugin({
+    {"packed", "store the packed data of each state"},
+    {"dictionary", "store each state as the indices of its bins in "
+     "dictionaries of the distinct values of each bin of the packed data, "
+     "using as few bits per index as the dictionary sizes allow"},
+    {"tree", "store each state as the root of a binary tree over the bins of "
+     "the packed data whose nodes are shared between all states (tree "
+     "compression); only saves memory if states have at least three bins"}
+});
@@ -0,0 +1,183 @@
+#ifndef COMPRESSED_STATE_REGISTRY_H
+#define COMPRESSED_STATE_REGISTRY_H
+
+#include "state_registry.h"
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+enum class StateStorage {
+    PACKED,
+    DICTIONARY,
+    TREE
+};
+
+/*
+  Base class for variants of StateRegistry that store states in
+  compressed form to fit more states into memory, at the cost of time.
+
+  Derived classes define a compressed representation with a fixed number
+  of bins, which they may change with change_compressed_size(). It must
+  be canonical (equal states have equal compressed representations), so
+  that duplicate detection can hash and compare compressed states
+  without unpacking them. The compressed representations are stored in
+  a RowTable whose row indices are the StateIDs.
+
+  lookup_state() unpacks the state into a buffer owned by the returned
+  State object, so looking up states is more expensive than with the
+  standard registry.
+*/
+class CompressedStateRegistry : public StateRegistry {
+protected:
+    /*
+      Stores each distinct row of row_size bins once and identifies it
+      by its index.
+    */
+    class RowTable {
+        int row_size;
+        segmented_vector::SegmentedArrayVector<PackedStateBin> rows;
+        StateIDSet row_ids;
+    public:
+        explicit RowTable(int row_size);
+
+        /*
+          Return the index of the given row and whether it was inserted
+          (i.e., was not contained in the table before).
+        */
+        std::pair<int, bool> insert(const PackedStateBin *row);
+
+        const PackedStateBin *operator[](int index) const {
+            return rows[index];
+        }
+
+        int get_row_size() const {
+            return row_size;
+        }
+
+        int size() const {
+            return rows.size();
+        }
+
+        void print_statistics(utils::LogProxy &log) const;
+    };
+
+    /*
+      Return the compressed representation of the given packed state. The
+      result only needs to stay valid until the next call.
+    */
+    virtual const PackedStateBin *compress(const PackedStateBin *buffer) = 0;
+    virtual void unpack(
+        const PackedStateBin *compressed, PackedStateBin *buffer) const = 0;
+    virtual void print_compression_statistics(utils::LogProxy &log) const = 0;
+
+    /*
+      Switch to compressed representations with new_size bins. convert
+      receives the old representation of every registered state and must
+      write its new representation. StateIDs do not change.
+    */
+    void change_compressed_size(
+        int new_size,
+        const std::function<void(const PackedStateBin *, PackedStateBin *)> &convert);
+private:
+    // Row i is the compressed representation of the state with ID i.
+    std::unique_ptr<RowTable> compressed_states;
+    std::vector<PackedStateBin> successor_buffer;
+public:
+    CompressedStateRegistry(const TaskProxy &task_proxy, int compressed_size);
+
+    virtual State lookup_state(StateID id) const override;
+
+    virtual State get_successor_state(
+        const State &predecessor, const OperatorProxy &op) override;
+
+    virtual void get_successor_states(
+        const State &predecessor, std::span<const OperatorID> operator_ids,
+        std::vector<State> &successors) override;
+
+    virtual State insert_state(const PackedStateBin *buffer) override;
+
+    virtual void print_statistics(utils::LogProxy &log) const override;
+};
+
+/*
+  Dictionary encoding: for every bin of the packed state data, a
+  dictionary stores each distinct value of the bin once, and a state is
+  represented by the indices of its bins in these dictionaries. The
+  indices are packed with as many bits as the current dictionary sizes
+  require. This pays off because reachable states usually only contain a
+  small fraction of the possible values of each bin, so that the
+  indices need much fewer bits than the bins themselves.
+
+  The bit widths grow by INDEX_BITS_INCREMENT bits when a dictionary
+  gets too large, which means that all registered states are converted
+  to the new width (see change_compressed_size()). Growing by several
+  bits at once keeps the number of conversions small.
+*/
+class DictionaryStateRegistry : public CompressedStateRegistry {
+    static const int INDEX_BITS_INCREMENT = 2;
+    // Dictionary indices must fit into the ranges of an IntPacker.
+    static const int MAX_INDEX_BITS = 30;
+
+    std::vector<std::unique_ptr<RowTable>> dictionaries;
+    // index_ranges[i]: number of indices that fit into the bits for bin i.
+    std::vector<int> index_ranges;
+    std::unique_ptr<int_packer::IntPacker> index_packer;
+    std::vector<int> indices;
+    std::vector<PackedStateBin> compressed_buffer;
+    int num_conversions;
+
+    void grow_index_ranges();
+protected:
+    virtual const PackedStateBin *compress(
+        const PackedStateBin *buffer) override;
+    virtual void unpack(
+        const PackedStateBin *compressed,
+        PackedStateBin *buffer) const override;
+    virtual void print_compression_statistics(
+        utils::LogProxy &log) const override;
+public:
+    explicit DictionaryStateRegistry(const TaskProxy &task_proxy);
+    virtual ~DictionaryStateRegistry() override;
+};
+
+/*
+  Tree compression (hash consing) as in LTSmin: the bins of the packed
+  state are recursively split into two halves. A half with a single bin
+  is represented by the value of the bin, larger halves by the index of
+  the pair of representations of their halves in a node table that is
+  shared by all states. A state is represented by the pair for its two
+  halves, i.e., by the children of the root of its tree.
+
+  States that share parts (e.g., a predecessor and its successor, which
+  usually differ in few bins) share the nodes for these parts, so each
+  new state typically only needs a few new nodes. The trees only have
+  inner nodes for states with at least three bins, so this only saves
+  memory for tasks with large states.
+*/
+class TreeStateRegistry : public CompressedStateRegistry {
+    RowTable nodes;
+    int num_bins;
+    std::vector<PackedStateBin> compressed_buffer;
+
+    PackedStateBin compress_bins(const PackedStateBin *buffer, int size);
+    void unpack_bins(
+        PackedStateBin compressed, int size, PackedStateBin *buffer) const;
+protected:
+    virtual const PackedStateBin *compress(
+        const PackedStateBin *buffer) override;
+    virtual void unpack(
+        const PackedStateBin *compressed,
+        PackedStateBin *buffer) const override;
+    virtual void print_compression_statistics(
+        utils::LogProxy &log) const override;
+public:
+    explicit TreeStateRegistry(const TaskProxy &task_proxy);
+    virtual ~TreeStateRegistry() override;
+};
+
+extern std::unique_ptr<StateRegistry> create_state_registry(
+    const TaskProxy &task_proxy, StateStorage storage);
+
+#endif
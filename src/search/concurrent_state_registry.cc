@@ -0,0 +1,119 @@
+#include "concurrent_state_registry.h"
+
+#include "task_proxy.h"
+
+#include "utils/logging.h"
+#include "utils/memory.h"
+
+#include <cstdint>
+
+using namespace std;
+
+ConcurrentStateRegistry::StateDataDirectory::StateDataDirectory()
+    : segments(new atomic<const PackedStateBin **>[MAX_SEGMENTS]) {
+    for (int i = 0; i < MAX_SEGMENTS; ++i) {
+        segments[i].store(nullptr, memory_order_relaxed);
+    }
+}
+
+ConcurrentStateRegistry::StateDataDirectory::~StateDataDirectory() {
+    for (int i = 0; i < MAX_SEGMENTS; ++i) {
+        delete[] segments[i].load(memory_order_relaxed);
+    }
+}
+
+void ConcurrentStateRegistry::StateDataDirectory::set(
+    int id, const PackedStateBin *buffer) {
+    assert(id >= 0);
+    atomic<const PackedStateBin **> &segment_ptr = segments[id >> SEGMENT_BITS];
+    const PackedStateBin **segment = segment_ptr.load(memory_order_acquire);
+    if (!segment) {
+        // Several threads may try to allocate the same segment. One wins.
+        const PackedStateBin **new_segment =
+            new const PackedStateBin *[SEGMENT_SIZE];
+        if (segment_ptr.compare_exchange_strong(
+                segment, new_segment, memory_order_acq_rel)) {
+            segment = new_segment;
+        } else {
+            delete[] new_segment;
+        }
+    }
+    segment[id & (SEGMENT_SIZE - 1)] = buffer;
+}
+
+
+ConcurrentStateRegistry::Shard::Shard(int num_bins)
+    : state_data_pool(num_bins),
+      registered_states(
+          StateIDSemanticHash(state_data_pool, num_bins),
+          StateIDSemanticEqual(state_data_pool, num_bins)) {
+}
+
+
+ConcurrentStateRegistry::ConcurrentStateRegistry(
+    const TaskProxy &task_proxy, int num_shards)
+    : StateRegistry(task_proxy) {
+    assert(num_shards >= 1);
+    shards.reserve(num_shards);
+    for (int i = 0; i < num_shards; ++i) {
+        shards.push_back(utils::make_unique_ptr<Shard>(get_bins_per_state()));
+    }
+}
+
+int ConcurrentStateRegistry::get_shard_index(int_hash_set::HashType hash) const {
+    return static_cast<int>((static_cast<uint64_t>(hash) * shards.size()) >> 32);
+}
+
+State ConcurrentStateRegistry::lookup_state(StateID id) const {
+    return task_proxy.create_state(*this, id, directory[id.value]);
+}
+
+State ConcurrentStateRegistry::get_successor_state(
+    const State &predecessor, const OperatorProxy &op) {
+    thread_local vector<PackedStateBin> buffer;
+    buffer.resize(get_bins_per_state());
+    compute_successor_buffer(predecessor, op, buffer.data());
+    return insert_state(buffer.data());
+}
+
+void ConcurrentStateRegistry::get_successor_states(
+    const State &predecessor, span<const OperatorID> operator_ids,
+    vector<State> &successors) {
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (OperatorID op_id : operator_ids) {
+        successors.push_back(
+            get_successor_state(predecessor, operators[op_id]));
+    }
+}
+
+State ConcurrentStateRegistry::insert_state(const PackedStateBin *buffer) {
+    int_hash_set::HashType hash =
+        get_packed_state_hash(buffer, get_bins_per_state());
+    Shard &shard = *shards[get_shard_index(hash)];
+    int id;
+    {
+        lock_guard<mutex> lock(shard.mutex);
+        shard.state_data_pool.push_back(buffer);
+        int index = shard.state_data_pool.size() - 1;
+        pair<int, bool> result = shard.registered_states.insert(index);
+        if (result.second) {
+            id = num_states.fetch_add(1, memory_order_relaxed);
+            directory.set(id, shard.state_data_pool[index]);
+            shard.state_ids.push_back(id);
+        } else {
+            shard.state_data_pool.pop_back();
+            id = shard.state_ids[result.first];
+        }
+    }
+    return lookup_state(StateID(id));
+}
+
+void ConcurrentStateRegistry::print_statistics(utils::LogProxy &log) const {
+    log << "Number of registered states: " << size() << endl;
+    log << "Number of registry shards: " << shards.size() << endl;
+    if (log.is_at_least_verbose()) {
+        for (const unique_ptr<Shard> &shard : shards) {
+            shard->registered_states.print_statistics(log);
+        }
+    }
+}
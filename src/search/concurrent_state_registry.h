@@ -0,0 +1,98 @@
+#ifndef CONCURRENT_STATE_REGISTRY_H
+#define CONCURRENT_STATE_REGISTRY_H
+
+#include "state_registry.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+  Thread-safe variant of StateRegistry that allows several search threads
+  to register and look up states concurrently without a global lock.
+
+  States are distributed to shards by the high bits of their hash (the
+  registries use the low bits to find buckets). Each shard stores the
+  packed data of its states in its own SegmentedArrayVector and detects
+  duplicates with its own IntHashSet, both protected by a per-shard
+  mutex. Threads that register states of different shards therefore
+  never wait for each other.
+
+  StateIDs are assigned from a global atomic counter, so they are dense
+  and PerStateInformation works as for the sequential registry. A
+  directory maps IDs to the packed data in the shards. Its segments are
+  allocated on demand and never move, so lookup_state() does not lock.
+
+  HDA* uses one such registry for all workers with the option
+  shared_registry=true.
+
+  Usage notes:
+  - A StateID may only be looked up by a thread that obtained it from the
+    registry or received it through some synchronization (e.g., a mutex
+    protecting a shared open list).
+  - PerStateInformation objects are not thread-safe themselves. Each
+    thread should use its own objects or protect shared ones.
+  - get_initial_state() must be called before threads are started.
+  - All registries of a task share its axiom evaluator, so
+    get_successor_state() is only thread-safe for tasks without axioms.
+*/
+class ConcurrentStateRegistry : public StateRegistry {
+    /*
+      Maps StateIDs to the packed data of the states. The directory
+      consists of up to MAX_SEGMENTS segments with SEGMENT_SIZE entries
+      each, which are allocated when the first ID in them is assigned.
+    */
+    class StateDataDirectory {
+        static const int SEGMENT_BITS = 16;
+        static const int SEGMENT_SIZE = 1 << SEGMENT_BITS;
+        static const int MAX_SEGMENTS = 1 << (31 - SEGMENT_BITS);
+
+        std::unique_ptr<std::atomic<const PackedStateBin **>[]> segments;
+    public:
+        StateDataDirectory();
+        ~StateDataDirectory();
+
+        void set(int id, const PackedStateBin *buffer);
+
+        const PackedStateBin *operator[](int id) const {
+            const PackedStateBin **segment =
+                segments[id >> SEGMENT_BITS].load(std::memory_order_acquire);
+            assert(segment);
+            return segment[id & (SEGMENT_SIZE - 1)];
+        }
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+        // Keys are indices into state_data_pool.
+        StateIDSet registered_states;
+        // Global StateID of every entry of state_data_pool.
+        segmented_vector::SegmentedVector<int> state_ids;
+
+        explicit Shard(int num_bins);
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    StateDataDirectory directory;
+
+    int get_shard_index(int_hash_set::HashType hash) const;
+public:
+    ConcurrentStateRegistry(const TaskProxy &task_proxy, int num_shards);
+
+    virtual State lookup_state(StateID id) const override;
+
+    virtual State get_successor_state(
+        const State &predecessor, const OperatorProxy &op) override;
+
+    virtual void get_successor_states(
+        const State &predecessor, std::span<const OperatorID> operator_ids,
+        std::vector<State> &successors) override;
+
+    virtual State insert_state(const PackedStateBin *buffer) override;
+
+    virtual void print_statistics(utils::LogProxy &log) const override;
+};
+
+#endif
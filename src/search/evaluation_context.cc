@@ -17,7 +17,8 @@ EvaluationContext::EvaluationContext(
       g_value(g_value),
       preferred(is_preferred),
       statistics(statistics),
-      calculate_preferred(calculate_preferred) {
+      calculate_preferred(calculate_preferred),
+      upper_bound_hint(EvaluationResult::INFTY) {
 }
 
 
@@ -96,3 +97,11 @@ EvaluationContext::get_preferred_operators(Evaluator *eval) {
 bool EvaluationContext::get_calculate_preferred() const {
     return calculate_preferred;
 }
+
+void EvaluationContext::set_upper_bound_hint(int bound) {
+    upper_bound_hint = bound;
+}
+
+int EvaluationContext::get_upper_bound_hint() const {
+    return upper_bound_hint;
+}
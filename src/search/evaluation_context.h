@@ -47,14 +47,21 @@ class EvaluationContext {
     bool preferred;
     SearchStatistics *statistics;
     bool calculate_preferred;
+    int upper_bound_hint;
 
     static const int INVALID = -1;
 
+public:
+    /*
+      Use existing evaluator results and compute missing ones as needed.
+      Used for example by eager search with results that are computed in
+      parallel. Evaluations in the given cache are not counted.
+    */
     EvaluationContext(
         const EvaluatorCache &cache, const State &state, int g_value,
         bool is_preferred, SearchStatistics *statistics,
-        bool calculate_preferred);
-public:
+        bool calculate_preferred = false);
+
     /*
       Copy existing heuristic cache and use it to look up heuristic values.
       Used for example by lazy search.
@@ -110,6 +117,18 @@ public:
     int get_evaluator_value_or_infinity(Evaluator *eval);
     const std::vector<OperatorID> &get_preferred_operators(Evaluator *eval);
     bool get_calculate_preferred() const;
+
+    /*
+      Tell the evaluators that the caller treats all values above the
+      given bound alike, e.g., because A* cannot find a plan below its
+      cost bound through such states. Evaluators may then return any
+      value above the bound, including infinity only for dead ends,
+      instead of computing their exact value when it exceeds the bound.
+      Evaluators are free to ignore the hint. By default, there is no
+      bound. Set the hint before any evaluator value is computed.
+    */
+    void set_upper_bound_hint(int bound);
+    int get_upper_bound_hint() const;
 };
 
 #endif
@@ -24,6 +24,10 @@ bool Evaluator::dead_ends_are_reliable() const {
     return true;
 }
 
+shared_ptr<Evaluator> Evaluator::create_thread_copy() const {
+    return nullptr;
+}
+
 void Evaluator::report_value_for_initial_state(
     const EvaluationResult &result) const {
     if (log.is_at_least_normal()) {
@@ -74,6 +78,10 @@ int Evaluator::get_cached_estimate(const State &) const {
     ABORT("Called get_cached_estimate when estimate is not cached.");
 }
 
+void Evaluator::set_cached_estimate(const State &, int) {
+    ABORT("Called set_cached_estimate for evaluator without cache.");
+}
+
 void add_evaluator_options_to_feature(plugins::Feature &feature) {
     utils::add_log_options_to_feature(feature);
 }
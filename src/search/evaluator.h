@@ -5,6 +5,7 @@
 
 #include "utils/logging.h"
 
+#include <memory>
 #include <set>
 
 class EvaluationContext;
@@ -50,6 +51,24 @@ public:
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) = 0;
 
+    /*
+      get_heuristics should insert all heuristics that this evaluator
+      directly or indirectly depends on into the result set, including
+      itself if it is a heuristic. Parallel evaluation (see
+      ParallelSuccessorEvaluator) computes these in several threads.
+    */
+    virtual void get_heuristics(std::set<Evaluator *> &evals) = 0;
+
+    /*
+      create_thread_copy should return an evaluator that computes the same
+      estimates as this one and can be used by another thread while this
+      evaluator is in use. The copy may share data with this evaluator
+      that neither of them modifies after construction.
+
+      The default implementation returns nullptr, which means that the
+      evaluator does not support this.
+    */
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const;
 
     virtual void notify_initial_state(const State & /*initial_state*/) {
     }
@@ -68,6 +87,10 @@ public:
       It should not add the result to the evaluation context -- this
       is done automatically elsewhere.
 
+      If the exact estimate exceeds the upper bound hint of the
+      evaluation context, compute_result may return any finite value
+      above the hint instead (see EvaluationContext).
+
       The passed-in evaluation context is not const because this
       evaluator might depend on other evaluators, in which case their
       results will be stored in the evaluation context as a side
@@ -98,6 +121,12 @@ public:
       the given state is cached, i.e., is_estimate_cached returns true.
     */
     virtual int get_cached_estimate(const State &state) const;
+    /*
+      Store an estimate that was computed elsewhere (e.g., by another
+      instance of the same evaluator). Calling set_cached_estimate is only
+      allowed if the evaluator caches its estimates.
+    */
+    virtual void set_cached_estimate(const State &state, int estimate);
 };
 
 extern void add_evaluator_options_to_feature(plugins::Feature &feature);
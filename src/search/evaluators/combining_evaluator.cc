@@ -52,6 +52,12 @@ void CombiningEvaluator::get_path_dependent_evaluators(
     for (auto &subevaluator : subevaluators)
         subevaluator->get_path_dependent_evaluators(evals);
 }
+
+void CombiningEvaluator::get_heuristics(set<Evaluator *> &evals) {
+    for (auto &subevaluator : subevaluators)
+        subevaluator->get_heuristics(evals);
+}
+
 void add_combining_evaluator_options_to_feature(plugins::Feature &feature) {
     feature.add_list_option<shared_ptr<Evaluator>>(
         "evals", "at least one evaluator");
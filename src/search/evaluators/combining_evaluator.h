@@ -14,9 +14,10 @@ namespace combining_evaluator {
   MaxEvaluator, which captures the common aspects of their behaviour.
 */
 class CombiningEvaluator : public Evaluator {
-    std::vector<std::shared_ptr<Evaluator>> subevaluators;
     bool all_dead_ends_are_reliable;
 protected:
+    std::vector<std::shared_ptr<Evaluator>> subevaluators;
+
     virtual int combine_values(const std::vector<int> &values) = 0;
 public:
     explicit CombiningEvaluator(const plugins::Options &opts);
@@ -41,6 +42,7 @@ public:
 
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) override;
+    virtual void get_heuristics(std::set<Evaluator *> &evals) override;
 };
 
 extern void add_combining_evaluator_options_to_feature(
@@ -19,6 +19,7 @@ public:
     explicit ConstEvaluator(const plugins::Options &opts);
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &) override {}
+    virtual void get_heuristics(std::set<Evaluator *> &) override {}
     virtual ~ConstEvaluator() override = default;
 };
 }
@@ -1,5 +1,8 @@
 #include "max_evaluator.h"
 
+#include "../evaluation_context.h"
+#include "../evaluation_result.h"
+
 #include "../plugins/plugin.h"
 
 #include <cassert>
@@ -14,6 +17,27 @@ MaxEvaluator::MaxEvaluator(const plugins::Options &opts)
 MaxEvaluator::~MaxEvaluator() {
 }
 
+EvaluationResult MaxEvaluator::compute_result(
+    EvaluationContext &eval_context) {
+    int upper_bound = eval_context.get_upper_bound_hint();
+    if (upper_bound == EvaluationResult::INFTY) {
+        return CombiningEvaluator::compute_result(eval_context);
+    }
+    // This marks no preferred operators.
+    EvaluationResult result;
+    int max_value = 0;
+    for (const shared_ptr<Evaluator> &subevaluator : subevaluators) {
+        int value = eval_context.get_evaluator_value_or_infinity(
+            subevaluator.get());
+        max_value = max(max_value, value);
+        if (max_value > upper_bound) {
+            break;
+        }
+    }
+    result.set_evaluator_value(max_value);
+    return result;
+}
+
 int MaxEvaluator::combine_values(const vector<int> &values) {
     int result = 0;
     for (int value : values) {
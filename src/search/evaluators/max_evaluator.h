@@ -17,6 +17,13 @@ protected:
 public:
     explicit MaxEvaluator(const plugins::Options &opts);
     virtual ~MaxEvaluator() override;
+
+    /*
+      Stop evaluating the subevaluators as soon as one of them exceeds the
+      upper bound hint of the evaluation context.
+    */
+    virtual EvaluationResult compute_result(
+        EvaluationContext &eval_context) override;
 };
 }
 
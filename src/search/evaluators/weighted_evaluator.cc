@@ -40,6 +40,10 @@ void WeightedEvaluator::get_path_dependent_evaluators(set<Evaluator *> &evals) {
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+void WeightedEvaluator::get_heuristics(set<Evaluator *> &evals) {
+    evaluator->get_heuristics(evals);
+}
+
 class WeightedEvaluatorFeature : public plugins::TypedFeature<Evaluator, WeightedEvaluator> {
 public:
     WeightedEvaluatorFeature() : TypedFeature("weight") {
@@ -22,6 +22,7 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) override;
     virtual void get_path_dependent_evaluators(std::set<Evaluator *> &evals) override;
+    virtual void get_heuristics(std::set<Evaluator *> &evals) override;
 };
 }
 
@@ -22,6 +22,14 @@ Heuristic::Heuristic(const plugins::Options &opts)
       task_proxy(*task) {
 }
 
+Heuristic::Heuristic(const Heuristic &other)
+    : Evaluator(other),
+      heuristic_cache(HEntry(NO_VALUE, true)),
+      cache_evaluator_values(other.cache_evaluator_values),
+      task(other.task),
+      task_proxy(*task) {
+}
+
 Heuristic::~Heuristic() {
 }
 
@@ -43,6 +51,11 @@ void Heuristic::add_options_to_feature(plugins::Feature &feature) {
     feature.add_option<bool>("cache_estimates", "cache heuristic estimates", "true");
 }
 
+int Heuristic::compute_bounded_heuristic(
+    const State &ancestor_state, int /*upper_bound*/) {
+    return compute_heuristic(ancestor_state);
+}
+
 EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     EvaluationResult result;
 
@@ -58,8 +71,15 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
         heuristic = heuristic_cache[state].h;
         result.set_count_evaluation(false);
     } else {
-        heuristic = compute_heuristic(state);
-        if (cache_evaluator_values) {
+        int upper_bound = eval_context.get_upper_bound_hint();
+        if (upper_bound == EvaluationResult::INFTY) {
+            heuristic = compute_heuristic(state);
+        } else {
+            heuristic = compute_bounded_heuristic(state, upper_bound);
+        }
+        // Values above the bound might not be exact, so we do not cache them.
+        if (cache_evaluator_values &&
+            (heuristic == DEAD_END || heuristic <= upper_bound)) {
             heuristic_cache[state] = HEntry(heuristic, false);
         }
         result.set_count_evaluation(true);
@@ -107,3 +127,8 @@ int Heuristic::get_cached_estimate(const State &state) const {
     assert(is_estimate_cached(state));
     return heuristic_cache[state].h;
 }
+
+void Heuristic::set_cached_estimate(const State &state, int estimate) {
+    assert(cache_evaluator_values);
+    heuristic_cache[state] = HEntry(estimate, false);
+}
@@ -63,6 +63,14 @@ protected:
 
     virtual int compute_heuristic(const State &ancestor_state) = 0;
 
+    /*
+      Heuristics that can stop early if their estimate exceeds the given
+      upper bound may override this method and return any value above the
+      bound in this case. By default, the exact estimate is computed.
+    */
+    virtual int compute_bounded_heuristic(
+        const State &ancestor_state, int upper_bound);
+
     /*
       Usage note: Marking the same operator as preferred multiple times
       is OK -- it will only appear once in the list of preferred
@@ -72,6 +80,12 @@ protected:
 
     State convert_ancestor_state(const State &ancestor_state) const;
 
+    /*
+      Copy the configuration of the given heuristic for create_thread_copy.
+      The copy starts with an empty cache.
+    */
+    Heuristic(const Heuristic &other);
+
 public:
     explicit Heuristic(const plugins::Options &opts);
     virtual ~Heuristic() override;
@@ -80,6 +94,10 @@ public:
         std::set<Evaluator *> & /*evals*/) override {
     }
 
+    virtual void get_heuristics(std::set<Evaluator *> &evals) override {
+        evals.insert(this);
+    }
+
     static void add_options_to_feature(plugins::Feature &feature);
 
     virtual EvaluationResult compute_result(
@@ -88,6 +106,7 @@ public:
     virtual bool does_cache_estimates() const override;
     virtual bool is_estimate_cached(const State &state) const override;
     virtual int get_cached_estimate(const State &state) const override;
+    virtual void set_cached_estimate(const State &state, int estimate) override;
 };
 
 #endif
@@ -16,10 +16,54 @@ const int AdditiveHeuristic::MAX_COST_VALUE;
 // construction and destruction
 AdditiveHeuristic::AdditiveHeuristic(const plugins::Options &opts)
     : RelaxationHeuristic(opts),
-      did_write_overflow_warning(false) {
+      did_write_overflow_warning(false),
+      max_cache_size(opts.get<int>("max_cache_size")),
+      exploration_cache(max_cache_size),
+      num_cache_uses(0),
+      cache_slots(-1),
+      parent_cache_slot(-1),
+      successor_registry(nullptr),
+      successor_id(StateID::no_state) {
     if (log.is_at_least_normal()) {
         log << "Initializing additive heuristic..." << endl;
     }
+    if (max_cache_size > 0) {
+        build_achievers();
+    }
+}
+
+AdditiveHeuristic::AdditiveHeuristic(const AdditiveHeuristic &other)
+    : RelaxationHeuristic(other),
+      did_write_overflow_warning(other.did_write_overflow_warning),
+      max_cache_size(other.max_cache_size),
+      exploration_cache(max_cache_size),
+      num_cache_uses(0),
+      cache_slots(-1),
+      parent_cache_slot(-1),
+      successor_registry(nullptr),
+      successor_id(StateID::no_state),
+      achievers_pool(other.achievers_pool),
+      achievers(other.achievers),
+      num_achievers(other.num_achievers) {
+}
+
+shared_ptr<Evaluator> AdditiveHeuristic::create_thread_copy() const {
+    return make_shared<AdditiveHeuristic>(*this);
+}
+
+void AdditiveHeuristic::build_achievers() {
+    int num_propositions = propositions.size();
+    vector<vector<OpID>> achievers_by_prop(num_propositions);
+    int num_unary_ops = unary_operators.size();
+    for (OpID op_id = 0; op_id < num_unary_ops; ++op_id) {
+        achievers_by_prop[unary_operators[op_id].effect].push_back(op_id);
+    }
+    achievers.reserve(num_propositions);
+    num_achievers.reserve(num_propositions);
+    for (const vector<OpID> &prop_achievers : achievers_by_prop) {
+        achievers.push_back(achievers_pool.append(prop_achievers));
+        num_achievers.push_back(prop_achievers.size());
+    }
 }
 
 void AdditiveHeuristic::write_overflow_warning() {
@@ -45,13 +89,12 @@ void AdditiveHeuristic::setup_exploration_queue() {
         prop.marked = false;
     }
 
-    // Deal with operators and axioms without preconditions.
-    for (UnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.num_preconditions;
-        op.cost = op.base_cost; // will be increased by precondition costs
+    reset_operator_data();
 
-        if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost, get_op_id(op));
+    // Deal with operators and axioms without preconditions.
+    for (OpID op_id : operators_without_preconditions) {
+        const UnaryOperator &op = unary_operators[op_id];
+        enqueue_if_necessary(op.effect, op.base_cost, op_id);
     }
 }
 
@@ -74,17 +117,18 @@ void AdditiveHeuristic::relaxed_exploration() {
         assert(prop_cost <= distance);
         if (prop_cost < distance)
             continue;
-        if (prop->is_goal && --unsolved_goals == 0)
+        // Cached explorations must be complete to be repairable.
+        if (prop->is_goal && --unsolved_goals == 0 && max_cache_size == 0)
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
-            UnaryOperator *unary_op = get_operator(op_id);
-            increase_cost(unary_op->cost, prop_cost);
-            --unary_op->unsatisfied_preconditions;
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect,
-                                     unary_op->cost, op_id);
+            UnaryOperatorData &op_data = operator_data[op_id];
+            increase_cost(op_data.cost, prop_cost);
+            --op_data.unsatisfied_preconditions;
+            assert(op_data.unsatisfied_preconditions >= 0);
+            if (op_data.unsatisfied_preconditions == 0)
+                enqueue_if_necessary(get_operator(op_id)->effect,
+                                     op_data.cost, op_id);
         }
     }
 }
@@ -115,10 +159,151 @@ void AdditiveHeuristic::mark_preferred_operators(
     }
 }
 
-int AdditiveHeuristic::compute_add_and_ff(const State &state) {
-    setup_exploration_queue();
-    setup_exploration_queue_state(state);
-    relaxed_exploration();
+bool AdditiveHeuristic::is_cached(const State &state, int slot) const {
+    if (slot == -1)
+        return false;
+    const CachedExploration &entry = exploration_cache[slot];
+    return entry.registry == state.get_registry() &&
+           entry.state_id == state.get_id();
+}
+
+void AdditiveHeuristic::compute_exploration_incrementally(
+    const State &ancestor_state, const State &state) {
+    int &slot = cache_slots[ancestor_state];
+    if (is_cached(ancestor_state, slot)) {
+        // The state is evaluated again, e.g., for preferred operators.
+        CachedExploration &entry = exploration_cache[slot];
+        entry.last_use = ++num_cache_uses;
+        propositions = entry.propositions;
+        return;
+    }
+
+    if (parent_cache_slot != -1 &&
+        successor_registry == ancestor_state.get_registry() &&
+        successor_id == ancestor_state.get_id()) {
+        CachedExploration &parent = exploration_cache[parent_cache_slot];
+        parent.last_use = ++num_cache_uses;
+        propositions = parent.propositions;
+        repair_exploration(parent.state_values, state);
+    } else {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration();
+    }
+    parent_cache_slot = -1;
+
+    slot = 0;
+    for (int i = 1; i < max_cache_size; ++i) {
+        if (exploration_cache[i].last_use < exploration_cache[slot].last_use)
+            slot = i;
+    }
+    CachedExploration &entry = exploration_cache[slot];
+    entry.last_use = ++num_cache_uses;
+    entry.registry = ancestor_state.get_registry();
+    entry.state_id = ancestor_state.get_id();
+    entry.state_values = state.get_unpacked_values();
+    entry.propositions = propositions;
+}
+
+void AdditiveHeuristic::repair_exploration(
+    const vector<int> &parent_values, const State &state) {
+    const vector<int> &values = state.get_unpacked_values();
+    int num_variables = values.size();
+    assert(static_cast<int>(parent_values.size()) == num_variables);
+
+    // Invalidate the deleted facts and everything supported by them.
+    invalidated_props.clear();
+    for (int var = 0; var < num_variables; ++var) {
+        if (parent_values[var] != values[var])
+            invalidate(get_prop_id(var, parent_values[var]));
+    }
+    for (size_t i = 0; i < invalidated_props.size(); ++i) {
+        Proposition *prop = get_proposition(invalidated_props[i]);
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            PropID effect = get_operator(op_id)->effect;
+            Proposition *effect_prop = get_proposition(effect);
+            if (effect_prop->cost != -1 && effect_prop->reached_by == op_id)
+                invalidate(effect);
+        }
+    }
+
+    /*
+      Seed the repair with the added facts and the cheapest remaining
+      achievers of the invalidated propositions. Queue entries only
+      become proposition costs when they are popped, so proposition
+      costs are final or -1 throughout the repair and operator costs
+      can be computed from them.
+    */
+    repair_queue.clear();
+    for (PropID prop_id : invalidated_props) {
+        int best_cost = -1;
+        OpID best_achiever = NO_OP;
+        for (OpID op_id : achievers_pool.get_slice(
+                 achievers[prop_id], num_achievers[prop_id])) {
+            int op_cost = compute_operator_cost(op_id);
+            if (op_cost != -1 && (best_cost == -1 || op_cost < best_cost)) {
+                best_cost = op_cost;
+                best_achiever = op_id;
+            }
+        }
+        if (best_achiever != NO_OP)
+            repair_queue.push(best_cost, make_pair(prop_id, best_achiever));
+    }
+    for (int var = 0; var < num_variables; ++var) {
+        if (parent_values[var] != values[var])
+            repair_queue.push(0, make_pair(get_prop_id(var, values[var]), NO_OP));
+    }
+
+    while (!repair_queue.empty()) {
+        pair<int, pair<PropID, OpID>> top_pair = repair_queue.pop();
+        int distance = top_pair.first;
+        Proposition *prop = get_proposition(top_pair.second.first);
+        if (prop->cost != -1 && prop->cost <= distance)
+            continue;
+        prop->cost = distance;
+        prop->reached_by = top_pair.second.second;
+        for (OpID op_id : precondition_of_pool.get_slice(
+                 prop->precondition_of, prop->num_precondition_occurences)) {
+            int op_cost = compute_operator_cost(op_id);
+            if (op_cost == -1)
+                continue;
+            PropID effect = get_operator(op_id)->effect;
+            int effect_cost = get_proposition(effect)->cost;
+            if (effect_cost == -1 || op_cost < effect_cost)
+                repair_queue.push(op_cost, make_pair(effect, op_id));
+        }
+    }
+}
+
+void AdditiveHeuristic::invalidate(PropID prop_id) {
+    Proposition *prop = get_proposition(prop_id);
+    assert(prop->cost != -1);
+    prop->cost = -1;
+    prop->reached_by = NO_OP;
+    invalidated_props.push_back(prop_id);
+}
+
+int AdditiveHeuristic::compute_operator_cost(OpID op_id) {
+    int cost = get_operator(op_id)->base_cost;
+    for (PropID precond : get_preconditions(op_id)) {
+        int precond_cost = get_proposition(precond)->cost;
+        if (precond_cost == -1)
+            return -1;
+        increase_cost(cost, precond_cost);
+    }
+    return cost;
+}
+
+int AdditiveHeuristic::compute_add_and_ff(
+    const State &ancestor_state, const State &state) {
+    if (max_cache_size > 0 && ancestor_state.get_registry()) {
+        compute_exploration_incrementally(ancestor_state, state);
+    } else {
+        setup_exploration_queue();
+        setup_exploration_queue_state(state);
+        relaxed_exploration();
+    }
 
     int total_cost = 0;
     for (PropID goal_id : goal_propositions) {
@@ -133,7 +318,7 @@ int AdditiveHeuristic::compute_add_and_ff(const State &state) {
 
 int AdditiveHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    int h = compute_add_and_ff(state);
+    int h = compute_add_and_ff(ancestor_state, state);
     if (h != DEAD_END) {
         for (PropID goal_id : goal_propositions)
             mark_preferred_operators(state, goal_id);
@@ -145,11 +330,39 @@ void AdditiveHeuristic::compute_heuristic_for_cegar(const State &state) {
     compute_heuristic(state);
 }
 
+void AdditiveHeuristic::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    // We need to know the parents of evaluated states.
+    if (max_cache_size > 0)
+        evals.insert(this);
+}
+
+void AdditiveHeuristic::notify_state_transition(
+    const State &parent_state, OperatorID, const State &state) {
+    assert(max_cache_size > 0);
+    int slot = cache_slots[parent_state];
+    parent_cache_slot = is_cached(parent_state, slot) ? slot : -1;
+    successor_registry = state.get_registry();
+    successor_id = state.get_id();
+}
+
+void add_additive_heuristic_options_to_feature(plugins::Feature &feature) {
+    feature.add_option<int>(
+        "max_cache_size",
+        "maximum number of cached relaxed explorations used for computing "
+        "the heuristic of successor states incrementally (set to 0 to "
+        "disable incremental computation). Each cached exploration needs "
+        "memory linear in the size of the task.",
+        "0",
+        plugins::Bounds("0", "infinity"));
+}
+
 class AdditiveHeuristicFeature : public plugins::TypedFeature<Evaluator, AdditiveHeuristic> {
 public:
     AdditiveHeuristicFeature() : TypedFeature("add") {
         document_title("Additive heuristic");
 
+        add_additive_heuristic_options_to_feature(*this);
         Heuristic::add_options_to_feature(*this);
 
         document_language_support("action costs", "supported");
@@ -7,6 +7,9 @@
 #include "../utils/collections.h"
 
 #include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 class State;
 
@@ -18,6 +21,7 @@ using relaxation_heuristic::NO_OP;
 
 using relaxation_heuristic::Proposition;
 using relaxation_heuristic::UnaryOperator;
+using relaxation_heuristic::UnaryOperatorData;
 
 class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     /* Costs larger than MAX_COST_VALUE are clamped to max_value. The
@@ -32,11 +36,65 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     priority_queues::AdaptiveQueue<PropID> queue;
     bool did_write_overflow_warning;
 
+    /*
+      Incremental evaluation (enabled if max_cache_size > 0).
+
+      The results of complete relaxed explorations are kept in a cache
+      of max_cache_size slots that are reused in LRU order. When a
+      successor of a state with a cached exploration is evaluated, the
+      heuristic starts from the cached proposition costs and only
+      repairs the part of the relaxed planning graph that depends on
+      changed facts: first, the costs of all propositions whose best
+      supporter (transitively) requires a deleted fact are invalidated,
+      then a Dijkstra exploration that starts at the added facts and the
+      invalidated propositions recomputes the costs that changed. The
+      repair computes the costs of the operators it touches from the
+      costs of their preconditions, so only propositions are cached.
+
+      h^add values are the same as with complete explorations, but best
+      supporters (and hence h^FF values and preferred operators) can
+      differ between operators of equal cost.
+    */
+    struct CachedExploration {
+        const StateRegistry *registry = nullptr;
+        StateID state_id = StateID::no_state;
+        std::vector<int> state_values;
+        std::vector<Proposition> propositions;
+        uint64_t last_use = 0;
+    };
+    const int max_cache_size;
+    std::vector<CachedExploration> exploration_cache;
+    uint64_t num_cache_uses;
+    PerStateInformation<int> cache_slots;
+    // Cache slot of the parent of the state that is evaluated next, or -1.
+    int parent_cache_slot;
+    const StateRegistry *successor_registry;
+    StateID successor_id;
+
+    // Unary operators achieving each proposition, indexed by PropID.
+    array_pool::ArrayPool achievers_pool;
+    std::vector<array_pool::ArrayPoolIndex> achievers;
+    std::vector<int> num_achievers;
+
+    // Entries are (proposition, best supporter) pairs.
+    priority_queues::AdaptiveQueue<std::pair<PropID, OpID>> repair_queue;
+    std::vector<PropID> invalidated_props;
+
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void relaxed_exploration();
     void mark_preferred_operators(const State &state, PropID goal_id);
 
+    void build_achievers();
+    bool is_cached(const State &state, int slot) const;
+    void compute_exploration_incrementally(
+        const State &ancestor_state, const State &state);
+    void repair_exploration(
+        const std::vector<int> &parent_values, const State &state);
+    void invalidate(PropID prop_id);
+    // Returns -1 if the operator has an unreached precondition.
+    int compute_operator_cost(OpID op_id);
+
     void enqueue_if_necessary(PropID prop_id, int cost, OpID op_id) {
         assert(cost >= 0);
         Proposition *prop = get_proposition(prop_id);
@@ -62,10 +120,27 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 
-    // Common part of h^add and h^ff computation.
-    int compute_add_and_ff(const State &state);
+    /*
+      Common part of h^add and h^ff computation. The ancestor state is
+      only used to look up and store cached explorations.
+    */
+    int compute_add_and_ff(const State &ancestor_state, const State &state);
 public:
     explicit AdditiveHeuristic(const plugins::Options &opts);
+    /*
+      Copies the relaxed task, but neither the state of the exploration
+      nor the cached explorations.
+    */
+    AdditiveHeuristic(const AdditiveHeuristic &other);
+
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const override;
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+
+    virtual void notify_state_transition(
+        const State &parent_state, OperatorID op_id,
+        const State &state) override;
 
     /*
       TODO: The two methods below are temporarily needed for the CEGAR
@@ -79,6 +154,9 @@ public:
         return get_proposition(var, value)->cost;
     }
 };
+
+extern void add_additive_heuristic_options_to_feature(
+    plugins::Feature &feature);
 }
 
 #endif
@@ -23,6 +23,10 @@ BlindSearchHeuristic::BlindSearchHeuristic(const plugins::Options &opts)
 BlindSearchHeuristic::~BlindSearchHeuristic() {
 }
 
+shared_ptr<Evaluator> BlindSearchHeuristic::create_thread_copy() const {
+    return make_shared<BlindSearchHeuristic>(*this);
+}
+
 int BlindSearchHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     if (task_properties::is_goal_state(task_proxy, state))
@@ -11,6 +11,8 @@ protected:
 public:
     BlindSearchHeuristic(const plugins::Options &opts);
     ~BlindSearchHeuristic();
+
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const override;
 };
 }
 
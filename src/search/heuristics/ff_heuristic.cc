@@ -19,6 +19,10 @@ FFHeuristic::FFHeuristic(const plugins::Options &opts)
     }
 }
 
+shared_ptr<Evaluator> FFHeuristic::create_thread_copy() const {
+    return make_shared<FFHeuristic>(*this);
+}
+
 void FFHeuristic::mark_preferred_operators_and_relaxed_plan(
     const State &state, PropID goal_id) {
     Proposition *goal = get_proposition(goal_id);
@@ -51,7 +55,7 @@ void FFHeuristic::mark_preferred_operators_and_relaxed_plan(
 
 int FFHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    int h_add = compute_add_and_ff(state);
+    int h_add = compute_add_and_ff(ancestor_state, state);
     if (h_add == DEAD_END)
         return h_add;
 
@@ -74,6 +78,7 @@ public:
     FFHeuristicFeature() : TypedFeature("ff") {
         document_title("FF heuristic");
 
+        additive_heuristic::add_additive_heuristic_options_to_feature(*this);
         Heuristic::add_options_to_feature(*this);
 
         document_language_support("action costs", "supported");
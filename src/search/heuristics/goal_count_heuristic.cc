@@ -15,6 +15,10 @@ GoalCountHeuristic::GoalCountHeuristic(const plugins::Options &opts)
     }
 }
 
+shared_ptr<Evaluator> GoalCountHeuristic::create_thread_copy() const {
+    return make_shared<GoalCountHeuristic>(*this);
+}
+
 int GoalCountHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     int unsatisfied_goal_count = 0;
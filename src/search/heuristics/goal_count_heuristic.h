@@ -9,6 +9,8 @@ protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
     explicit GoalCountHeuristic(const plugins::Options &opts);
+
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const override;
 };
 }
 
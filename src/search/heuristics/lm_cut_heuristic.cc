@@ -22,9 +22,18 @@ LandmarkCutHeuristic::LandmarkCutHeuristic(const plugins::Options &opts)
     }
 }
 
+LandmarkCutHeuristic::LandmarkCutHeuristic(const LandmarkCutHeuristic &other)
+    : Heuristic(other),
+      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)) {
+}
+
 LandmarkCutHeuristic::~LandmarkCutHeuristic() {
 }
 
+shared_ptr<Evaluator> LandmarkCutHeuristic::create_thread_copy() const {
+    return make_shared<LandmarkCutHeuristic>(*this);
+}
+
 int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     int total_cost = 0;
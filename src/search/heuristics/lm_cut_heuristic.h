@@ -18,7 +18,11 @@ class LandmarkCutHeuristic : public Heuristic {
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
     explicit LandmarkCutHeuristic(const plugins::Options &opts);
+    // Builds new landmark data structures for the task of the given heuristic.
+    LandmarkCutHeuristic(const LandmarkCutHeuristic &other);
     virtual ~LandmarkCutHeuristic() override;
+
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const override;
 };
 }
 
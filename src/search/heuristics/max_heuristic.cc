@@ -29,6 +29,14 @@ HSPMaxHeuristic::HSPMaxHeuristic(const plugins::Options &opts)
     }
 }
 
+HSPMaxHeuristic::HSPMaxHeuristic(const HSPMaxHeuristic &other)
+    : RelaxationHeuristic(other) {
+}
+
+shared_ptr<Evaluator> HSPMaxHeuristic::create_thread_copy() const {
+    return make_shared<HSPMaxHeuristic>(*this);
+}
+
 // heuristic computation
 void HSPMaxHeuristic::setup_exploration_queue() {
     queue.clear();
@@ -36,13 +44,12 @@ void HSPMaxHeuristic::setup_exploration_queue() {
     for (Proposition &prop : propositions)
         prop.cost = -1;
 
-    // Deal with operators and axioms without preconditions.
-    for (UnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.num_preconditions;
-        op.cost = op.base_cost; // will be increased by precondition costs
+    reset_operator_data();
 
-        if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost);
+    // Deal with operators and axioms without preconditions.
+    for (OpID op_id : operators_without_preconditions) {
+        const UnaryOperator &op = unary_operators[op_id];
+        enqueue_if_necessary(op.effect, op.base_cost);
     }
 }
 
@@ -69,13 +76,19 @@ void HSPMaxHeuristic::relaxed_exploration() {
             return;
         for (OpID op_id : precondition_of_pool.get_slice(
                  prop->precondition_of, prop->num_precondition_occurences)) {
-            UnaryOperator *unary_op = get_operator(op_id);
-            unary_op->cost = max(unary_op->cost,
-                                 unary_op->base_cost + prop_cost);
-            --unary_op->unsatisfied_preconditions;
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect, unary_op->cost);
+            UnaryOperatorData &op_data = operator_data[op_id];
+            --op_data.unsatisfied_preconditions;
+            assert(op_data.unsatisfied_preconditions >= 0);
+            if (op_data.unsatisfied_preconditions == 0) {
+                /*
+                  Propositions are expanded in order of increasing cost,
+                  so prop is the most expensive precondition of the
+                  operator and determines its h^max cost.
+                */
+                const UnaryOperator *unary_op = get_operator(op_id);
+                op_data.cost = unary_op->base_cost + prop_cost;
+                enqueue_if_necessary(unary_op->effect, op_data.cost);
+            }
         }
     }
 }
@@ -13,6 +13,7 @@ using relaxation_heuristic::OpID;
 
 using relaxation_heuristic::Proposition;
 using relaxation_heuristic::UnaryOperator;
+using relaxation_heuristic::UnaryOperatorData;
 
 class HSPMaxHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     priority_queues::AdaptiveQueue<PropID> queue;
@@ -34,6 +35,10 @@ protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
     explicit HSPMaxHeuristic(const plugins::Options &opts);
+    // Copies the relaxed task, but not the state of the exploration.
+    HSPMaxHeuristic(const HSPMaxHeuristic &other);
+
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const override;
 };
 }
 
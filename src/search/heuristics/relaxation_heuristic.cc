@@ -90,6 +90,16 @@ RelaxationHeuristic::RelaxationHeuristic(const plugins::Options &opts)
             precondition_of_pool.append(precondition_of_vec);
         propositions[prop_id].num_precondition_occurences = precondition_of_vec.size();
     }
+
+    initial_operator_data.reserve(num_unary_ops);
+    for (OpID op_id = 0; op_id < num_unary_ops; ++op_id) {
+        const UnaryOperator &op = unary_operators[op_id];
+        // Costs will be increased by precondition costs.
+        initial_operator_data.push_back({op.base_cost, op.num_preconditions});
+        if (op.num_preconditions == 0)
+            operators_without_preconditions.push_back(op_id);
+    }
+    operator_data.resize(num_unary_ops);
 }
 
 bool RelaxationHeuristic::dead_ends_are_reliable() const {
@@ -7,6 +7,7 @@
 
 #include "../utils/collections.h"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
@@ -37,14 +38,25 @@ struct Proposition {
 
 static_assert(sizeof(Proposition) == 16, "Proposition has wrong size");
 
+/*
+  Data of a unary operator that changes during the relaxed exploration.
+  It is stored apart from the static data in UnaryOperator, so that the
+  inner loop of the exploration accesses 8 instead of 28 bytes per
+  operator and all operators can be reset with a single contiguous copy.
+*/
+struct UnaryOperatorData {
+    int cost; // Used for h^max cost or h^add cost;
+              // includes operator cost (base_cost)
+    int unsatisfied_preconditions;
+};
+
+static_assert(sizeof(UnaryOperatorData) == 8, "UnaryOperatorData has wrong size");
+
 struct UnaryOperator {
     UnaryOperator(int num_preconditions,
                   array_pool::ArrayPoolIndex preconditions,
                   PropID effect,
                   int operator_no, int base_cost);
-    int cost; // Used for h^max cost or h^add cost;
-              // includes operator cost (base_cost)
-    int unsatisfied_preconditions;
     PropID effect;
     int base_cost;
     int num_preconditions;
@@ -52,7 +64,7 @@ struct UnaryOperator {
     int operator_no; // -1 for axioms; index into the task's operators otherwise
 };
 
-static_assert(sizeof(UnaryOperator) == 28, "UnaryOperator has wrong size");
+static_assert(sizeof(UnaryOperator) == 20, "UnaryOperator has wrong size");
 
 class RelaxationHeuristic : public Heuristic {
     void build_unary_operators(const OperatorProxy &op);
@@ -68,6 +80,18 @@ protected:
     array_pool::ArrayPool preconditions_pool;
     array_pool::ArrayPool precondition_of_pool;
 
+    // Indexed by OpID.
+    std::vector<UnaryOperatorData> operator_data;
+    // Content of operator_data at the start of each exploration.
+    std::vector<UnaryOperatorData> initial_operator_data;
+    // Unary operators without preconditions, ordered by ID.
+    std::vector<OpID> operators_without_preconditions;
+
+    void reset_operator_data() {
+        std::copy(initial_operator_data.begin(), initial_operator_data.end(),
+                  operator_data.begin());
+    }
+
     array_pool::ArrayPoolSlice get_preconditions(OpID op_id) const {
         const UnaryOperator &op = unary_operators[op_id];
         return preconditions_pool.get_slice(op.preconditions, op.num_preconditions);
@@ -0,0 +1,223 @@
+#include "factor_cache.h"
+
+#include "merge_and_shrink_representation.h"
+
+#include "../task_proxy.h"
+
+#include "../utils/hash.h"
+#include "../utils/logging.h"
+#include "../utils/system.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+namespace merge_and_shrink {
+/*
+  A cache file consists of the 32-bit words MAGIC, FORMAT_VERSION, the
+  halves of the task hash and of the configuration hash and the number of
+  representations, followed by the representations in the format of
+  FlatMergeAndShrinkRepresentation::write().
+*/
+static const uint32_t MAGIC = 0x4653414d;
+static const uint32_t FORMAT_VERSION = 2;
+static const string CACHE_OPTION = "factor_cache=";
+
+static filesystem::path get_cache_directory() {
+    const char *directory = getenv("DOWNWARD_MAS_CACHE_DIR");
+    if (!directory)
+        return filesystem::path();
+    return filesystem::path(directory);
+}
+
+static uint64_t compute_task_hash(const TaskProxy &task_proxy) {
+    utils::HashState hash_state;
+    VariablesProxy variables = task_proxy.get_variables();
+    utils::feed(hash_state, static_cast<int>(variables.size()));
+    for (VariableProxy var : variables) {
+        utils::feed(hash_state, var.get_domain_size());
+        utils::feed(hash_state, var.is_derived() ? var.get_axiom_layer() : -1);
+    }
+    State initial_state = task_proxy.get_initial_state();
+    initial_state.unpack();
+    utils::feed(hash_state, initial_state);
+    auto feed_facts = [&](const auto &facts) {
+            for (FactProxy fact : facts) {
+                utils::feed(hash_state, fact.get_pair());
+            }
+            // Separate the lists of facts.
+            utils::feed(hash_state, -1);
+        };
+    feed_facts(task_proxy.get_goals());
+    auto feed_operators = [&](const auto &operators) {
+            for (OperatorProxy op : operators) {
+                utils::feed(hash_state, op.get_cost());
+                feed_facts(op.get_preconditions());
+                for (EffectProxy effect : op.get_effects()) {
+                    feed_facts(effect.get_conditions());
+                    utils::feed(hash_state, effect.get_fact().get_pair());
+                }
+                utils::feed(hash_state, -1);
+            }
+            utils::feed(hash_state, -1);
+        };
+    feed_operators(task_proxy.get_operators());
+    feed_operators(task_proxy.get_axioms());
+    return hash_state.get_hash64();
+}
+
+/*
+  The parser stores configurations in lower case and without whitespace.
+  We remove the factor_cache argument, so that the runs writing and
+  loading the factors of a configuration use the same file.
+*/
+static uint64_t compute_config_hash(const string &config) {
+    string stripped_config = config;
+    size_t pos = stripped_config.find(CACHE_OPTION);
+    while (pos != string::npos) {
+        if (pos > 0 && (stripped_config[pos - 1] == '(' ||
+                        stripped_config[pos - 1] == ',')) {
+            size_t end = stripped_config.find_first_of(",)", pos);
+            if (end != string::npos && stripped_config[end] == ',') {
+                // Remove the argument and the comma that follows it.
+                ++end;
+            } else if (stripped_config[pos - 1] == ',') {
+                // Remove the last argument and the comma before it.
+                --pos;
+            }
+            stripped_config.erase(pos, end - pos);
+        } else {
+            ++pos;
+        }
+        pos = stripped_config.find(CACHE_OPTION, pos);
+    }
+    utils::HashState hash_state;
+    for (char c : stripped_config) {
+        utils::feed(hash_state, static_cast<int>(c));
+    }
+    return hash_state.get_hash64();
+}
+
+static filesystem::path get_cache_file_path(
+    const filesystem::path &directory, uint64_t task_hash,
+    uint64_t config_hash) {
+    ostringstream name;
+    name << hex << setfill('0') << setw(16) << task_hash << "-"
+         << setw(16) << config_hash << ".mas";
+    return directory / name.str();
+}
+
+static vector<uint32_t> create_header(
+    uint64_t task_hash, uint64_t config_hash) {
+    return {
+        MAGIC, FORMAT_VERSION,
+        static_cast<uint32_t>(task_hash),
+        static_cast<uint32_t>(task_hash >> 32),
+        static_cast<uint32_t>(config_hash),
+        static_cast<uint32_t>(config_hash >> 32)};
+}
+
+bool load_factors_from_cache(
+    const TaskProxy &task_proxy, const string &config,
+    vector<FlatMergeAndShrinkRepresentation> &representations,
+    utils::LogProxy &log) {
+    assert(representations.empty());
+    filesystem::path directory = get_cache_directory();
+    if (directory.empty())
+        return false;
+    uint64_t task_hash = compute_task_hash(task_proxy);
+    uint64_t config_hash = compute_config_hash(config);
+    filesystem::path path =
+        get_cache_file_path(directory, task_hash, config_hash);
+    ifstream file(path, ios::binary);
+    if (!file)
+        return false;
+
+    /*
+      Files with a different header were written by another version of
+      the planner. We ignore them, as well as files that end early or
+      contain invalid representations.
+    */
+    vector<uint32_t> header = create_header(task_hash, config_hash);
+    vector<uint32_t> file_header(header.size());
+    uint32_t num_representations;
+    if (!file.read(reinterpret_cast<char *>(file_header.data()),
+                   file_header.size() * sizeof(uint32_t)) ||
+        file_header != header ||
+        !file.read(reinterpret_cast<char *>(&num_representations),
+                   sizeof(num_representations))) {
+        return false;
+    }
+    vector<int> domain_sizes;
+    for (VariableProxy var : task_proxy.get_variables()) {
+        domain_sizes.push_back(var.get_domain_size());
+    }
+    vector<FlatMergeAndShrinkRepresentation> loaded_representations;
+    for (uint32_t i = 0; i < num_representations; ++i) {
+        unique_ptr<FlatMergeAndShrinkRepresentation> representation =
+            FlatMergeAndShrinkRepresentation::read(file, domain_sizes);
+        if (!representation) {
+            return false;
+        }
+        loaded_representations.push_back(move(*representation));
+    }
+    if (file.peek() != ifstream::traits_type::eof()) {
+        return false;
+    }
+    representations = move(loaded_representations);
+    if (log.is_at_least_normal()) {
+        log << "Loaded " << num_representations
+            << " merge-and-shrink factor(s) from cache file " << path << endl;
+    }
+    return true;
+}
+
+void save_factors_to_cache(
+    const TaskProxy &task_proxy, const string &config,
+    const vector<FlatMergeAndShrinkRepresentation> &representations,
+    utils::LogProxy &log) {
+    filesystem::path directory = get_cache_directory();
+    if (directory.empty())
+        return;
+    uint64_t task_hash = compute_task_hash(task_proxy);
+    uint64_t config_hash = compute_config_hash(config);
+    filesystem::path path =
+        get_cache_file_path(directory, task_hash, config_hash);
+    vector<uint32_t> header = create_header(task_hash, config_hash);
+    header.push_back(representations.size());
+
+    /*
+      Write to a temporary file first and rename it afterwards, so that
+      concurrent planner runs never see incomplete files.
+    */
+    filesystem::path tmp_path = path;
+    tmp_path += "." + to_string(utils::get_process_id()) + ".tmp";
+    error_code error;
+    filesystem::create_directories(directory, error);
+    ofstream file(tmp_path, ios::binary);
+    file.write(reinterpret_cast<const char *>(header.data()),
+               header.size() * sizeof(uint32_t));
+    for (const FlatMergeAndShrinkRepresentation &representation :
+         representations) {
+        representation.write(file);
+    }
+    file.close();
+    if (file) {
+        filesystem::rename(tmp_path, path, error);
+    }
+    if (!file || error) {
+        filesystem::remove(tmp_path, error);
+        log << "Could not write merge-and-shrink factors to cache file "
+            << path << endl;
+    } else if (log.is_at_least_normal()) {
+        log << "Wrote " << representations.size()
+            << " merge-and-shrink factor(s) to cache file " << path << endl;
+    }
+}
+}
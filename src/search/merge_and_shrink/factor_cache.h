@@ -0,0 +1,41 @@
+#ifndef MERGE_AND_SHRINK_FACTOR_CACHE_H
+#define MERGE_AND_SHRINK_FACTOR_CACHE_H
+
+#include <string>
+#include <vector>
+
+class TaskProxy;
+
+namespace utils {
+class LogProxy;
+}
+
+namespace merge_and_shrink {
+class FlatMergeAndShrinkRepresentation;
+
+/*
+  Cache of the final factors of merge-and-shrink heuristics on disk that
+  lets later planner runs on the same task skip the merge-and-shrink
+  algorithm. The cache is only used if the environment variable
+  DOWNWARD_MAS_CACHE_DIR names a directory for the cache files.
+
+  A cache file holds the final representations, which store the goal
+  distances. It is identified by a hash of the task (variables, initial
+  state, goals and operators with their costs) and a hash of the
+  configuration of the heuristic as written on the command line, without
+  its factor_cache option. The file repeats both hashes, so files of
+  other tasks or configurations are never loaded. Variables bound with
+  "let" enter the configuration only by their names.
+*/
+extern bool load_factors_from_cache(
+    const TaskProxy &task_proxy, const std::string &config,
+    std::vector<FlatMergeAndShrinkRepresentation> &representations,
+    utils::LogProxy &log);
+
+extern void save_factors_to_cache(
+    const TaskProxy &task_proxy, const std::string &config,
+    const std::vector<FlatMergeAndShrinkRepresentation> &representations,
+    utils::LogProxy &log);
+}
+
+#endif
@@ -31,6 +31,8 @@ class FTSFactory {
 
         vector<int> label_to_local_label;
         vector<LocalLabelInfo> local_label_infos;
+        // The transitions of each local label, stored in one array later.
+        vector<vector<Transition>> transitions_by_local_label;
         vector<bool> relevant_labels;
         int num_states;
         vector<bool> goal_states;
@@ -40,6 +42,7 @@ class FTSFactory {
               incorporated_variables(move(other.incorporated_variables)),
               label_to_local_label(move(other.label_to_local_label)),
               local_label_infos(move(other.local_label_infos)),
+              transitions_by_local_label(move(other.transitions_by_local_label)),
               relevant_labels(move(other.relevant_labels)),
               num_states(other.num_states),
               goal_states(move(other.goal_states)),
@@ -306,10 +309,13 @@ void FTSFactory::build_transitions_for_operator(OperatorProxy op) {
         vector<int> &label_to_local_label =
             transition_system_data_by_var[var_id].label_to_local_label;
         vector<LocalLabelInfo> &local_label_infos = transition_system_data_by_var[var_id].local_label_infos;
+        vector<vector<Transition>> &transitions_by_local_label =
+            transition_system_data_by_var[var_id].transitions_by_local_label;
         bool found_locally_equivalent_label_group = false;
         for (size_t local_label = 0; local_label < local_label_infos.size(); ++local_label) {
             LocalLabelInfo &local_label_info = local_label_infos[local_label];
-            const vector<Transition> &local_label_transitions = local_label_info.get_transitions();
+            const vector<Transition> &local_label_transitions =
+                transitions_by_local_label[local_label];
             if (transitions == local_label_transitions) {
                 assert(label_to_local_label[label] == -1);
                 label_to_local_label[label] = local_label;
@@ -322,7 +328,8 @@ void FTSFactory::build_transitions_for_operator(OperatorProxy op) {
         if (!found_locally_equivalent_label_group) {
             int new_local_label = local_label_infos.size();
             LabelGroup label_group = {label};
-            local_label_infos.emplace_back(move(label_group), move(transitions), label_cost);
+            local_label_infos.emplace_back(move(label_group), 0, 0, label_cost);
+            transitions_by_local_label.push_back(move(transitions));
             assert(label_to_local_label[label] == -1);
             label_to_local_label[label] = new_local_label;
         }
@@ -356,7 +363,8 @@ void FTSFactory::build_transitions_for_irrelevant_ops(
             ts_data.label_to_local_label[label] = new_local_label;
         }
         ts_data.local_label_infos.emplace_back(
-            move(irrelevant_labels), move(transitions), cost);
+            move(irrelevant_labels), 0, 0, cost);
+        ts_data.transitions_by_local_label.push_back(move(transitions));
     }
 }
 
@@ -388,12 +396,31 @@ vector<unique_ptr<TransitionSystem>> FTSFactory::create_transition_systems(const
 
     for (int var_id = 0; var_id < num_variables; ++var_id) {
         TransitionSystemData &ts_data = transition_system_data_by_var[var_id];
+        size_t num_transitions = 0;
+        for (const vector<Transition> &transitions : ts_data.transitions_by_local_label) {
+            num_transitions += transitions.size();
+        }
+        vector<Transition> transitions;
+        transitions.reserve(num_transitions);
+        for (size_t local_label = 0; local_label < ts_data.local_label_infos.size();
+             ++local_label) {
+            vector<Transition> &local_label_transitions =
+                ts_data.transitions_by_local_label[local_label];
+            size_t transitions_begin = transitions.size();
+            transitions.insert(
+                transitions.end(),
+                local_label_transitions.begin(), local_label_transitions.end());
+            utils::release_vector_memory(local_label_transitions);
+            ts_data.local_label_infos[local_label].set_transition_range(
+                transitions_begin, transitions.size());
+        }
         result.push_back(utils::make_unique_ptr<TransitionSystem>(
                              ts_data.num_variables,
                              move(ts_data.incorporated_variables),
                              labels,
                              move(ts_data.label_to_local_label),
                              move(ts_data.local_label_infos),
+                             move(transitions),
                              ts_data.num_states,
                              move(ts_data.goal_states),
                              ts_data.init_state
@@ -1,6 +1,7 @@
 #include "merge_and_shrink_heuristic.h"
 
 #include "distances.h"
+#include "factor_cache.h"
 #include "factored_transition_system.h"
 #include "merge_and_shrink_algorithm.h"
 #include "merge_and_shrink_representation.h"
@@ -21,14 +22,35 @@ using utils::ExitCode;
 
 namespace merge_and_shrink {
 MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const plugins::Options &opts)
-    : Heuristic(opts) {
+    : Heuristic(opts),
+      mas_representations(
+          make_shared<vector<FlatMergeAndShrinkRepresentation>>()) {
     log << "Initializing merge-and-shrink heuristic..." << endl;
-    MergeAndShrinkAlgorithm algorithm(opts);
-    FactoredTransitionSystem fts = algorithm.build_factored_transition_system(task_proxy);
-    extract_factors(fts);
+    FactorCache factor_cache = opts.get<FactorCache>("factor_cache");
+    const string &config = opts.get_unparsed_config();
+    if (factor_cache != FactorCache::LOAD ||
+        !load_factors_from_cache(task_proxy, config, *mas_representations, log)) {
+        MergeAndShrinkAlgorithm algorithm(opts);
+        FactoredTransitionSystem fts = algorithm.build_factored_transition_system(task_proxy);
+        extract_factors(fts);
+        if (factor_cache != FactorCache::NONE) {
+            save_factors_to_cache(task_proxy, config, *mas_representations, log);
+        }
+    }
+    for (const FlatMergeAndShrinkRepresentation &mas_representation :
+         *mas_representations) {
+        int stack_size = mas_representation.get_max_stack_size();
+        if (static_cast<int>(value_stack.size()) < stack_size) {
+            value_stack.resize(stack_size);
+        }
+    }
     log << "Done initializing merge-and-shrink heuristic." << endl << endl;
 }
 
+shared_ptr<Evaluator> MergeAndShrinkHeuristic::create_thread_copy() const {
+    return make_shared<MergeAndShrinkHeuristic>(*this);
+}
+
 void MergeAndShrinkHeuristic::extract_factor(
     FactoredTransitionSystem &fts, int index) {
     /*
@@ -46,7 +68,7 @@ void MergeAndShrinkHeuristic::extract_factor(
     }
     assert(distances->are_goal_distances_computed());
     mas_representation->set_distances(*distances);
-    mas_representations.push_back(move(mas_representation));
+    mas_representations->emplace_back(*mas_representation);
 }
 
 bool MergeAndShrinkHeuristic::extract_unsolvable_factor(FactoredTransitionSystem &fts) {
@@ -54,7 +76,7 @@ bool MergeAndShrinkHeuristic::extract_unsolvable_factor(FactoredTransitionSystem
        return true. Otherwise, return false. */
     for (int index : fts) {
         if (!fts.is_factor_solvable(index)) {
-            mas_representations.reserve(1);
+            mas_representations->reserve(1);
             extract_factor(fts, index);
             if (log.is_at_least_normal()) {
                 log << fts.get_transition_system(index).tag()
@@ -90,7 +112,7 @@ void MergeAndShrinkHeuristic::extract_factors(FactoredTransitionSystem &fts) {
       factored_transition_system.h on improving the interface of that class
       (and also related classes like TransitionSystem etc).
     */
-    assert(mas_representations.empty());
+    assert(mas_representations->empty());
 
     int num_active_factors = fts.get_num_active_entries();
     if (log.is_at_least_normal()) {
@@ -102,7 +124,7 @@ void MergeAndShrinkHeuristic::extract_factors(FactoredTransitionSystem &fts) {
         extract_nontrivial_factors(fts);
     }
 
-    int num_factors_kept = mas_representations.size();
+    int num_factors_kept = mas_representations->size();
     if (log.is_at_least_normal()) {
         log << "Number of factors kept: " << num_factors_kept << endl;
     }
@@ -110,10 +132,12 @@ void MergeAndShrinkHeuristic::extract_factors(FactoredTransitionSystem &fts) {
 
 int MergeAndShrinkHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
+    state.unpack();
+    const vector<int> &state_values = state.get_unpacked_values();
     int heuristic = 0;
-    for (const unique_ptr<MergeAndShrinkRepresentation> &mas_representation : mas_representations) {
-        int cost = mas_representation->get_value(state);
-        if (cost == PRUNED_STATE || cost == INF) {
+    for (const FlatMergeAndShrinkRepresentation &mas_representation : *mas_representations) {
+        int cost = mas_representation.get_value(state_values, value_stack);
+        if (cost == PRUNED_STATE) {
             // If state is unreachable or irrelevant, we encountered a dead end.
             return DEAD_END;
         }
@@ -173,6 +197,17 @@ public:
 
         Heuristic::add_options_to_feature(*this);
         add_merge_and_shrink_algorithm_options_to_feature(*this);
+        add_option<FactorCache>(
+            "factor_cache",
+            "store the final factors in a cache on disk or reuse them from "
+            "there. The cache is only used if the environment variable "
+            "DOWNWARD_MAS_CACHE_DIR names a directory for the cache files. "
+            "Cached factors are identified by the task and the configuration "
+            "of the heuristic without this option. Components bound with "
+            "'let' only enter the configuration by their names, so do not "
+            "bind different components to the same name in runs that share "
+            "the cache.",
+            "none");
 
         document_note(
             "Note",
@@ -232,4 +267,13 @@ public:
 };
 
 static plugins::FeaturePlugin<MergeAndShrinkHeuristicFeature> _plugin;
+
+static plugins::TypedEnumPlugin<FactorCache> _enum_plugin({
+        {"none", "compute the factors without using the cache"},
+        {"write",
+         "compute the factors and write them to the cache"},
+        {"load",
+         "load the factors from the cache if the cache has them for this "
+         "task; otherwise compute them and write them to the cache"}
+    });
 }
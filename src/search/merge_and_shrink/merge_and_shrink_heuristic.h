@@ -1,17 +1,29 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_HEURISTIC_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_HEURISTIC_H
 
+#include "merge_and_shrink_representation.h"
+
 #include "../heuristic.h"
 
 #include <memory>
 
 namespace merge_and_shrink {
 class FactoredTransitionSystem;
-class MergeAndShrinkRepresentation;
+
+enum class FactorCache {
+    NONE,
+    WRITE,
+    LOAD
+};
 
 class MergeAndShrinkHeuristic : public Heuristic {
-    // The final merge-and-shrink representations, storing goal distances.
-    std::vector<std::unique_ptr<MergeAndShrinkRepresentation>> mas_representations;
+    /*
+      The final merge-and-shrink representations, storing goal distances.
+      Copies created by create_thread_copy share them.
+    */
+    std::shared_ptr<std::vector<FlatMergeAndShrinkRepresentation>> mas_representations;
+    // Stack for evaluating the representations.
+    std::vector<int> value_stack;
 
     void extract_factor(FactoredTransitionSystem &fts, int index);
     bool extract_unsolvable_factor(FactoredTransitionSystem &fts);
@@ -21,6 +33,8 @@ protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
     explicit MergeAndShrinkHeuristic(const plugins::Options &opts);
+
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const override;
 };
 }
 
@@ -10,6 +10,8 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <istream>
+#include <limits>
 #include <numeric>
 
 using namespace std;
@@ -81,6 +83,13 @@ void MergeAndShrinkRepresentationLeaf::dump(utils::LogProxy &log) const {
     }
 }
 
+void MergeAndShrinkRepresentationLeaf::append_flat_nodes(
+    vector<FlatRepresentationNode> &nodes, vector<int> &lookup_tables) const {
+    nodes.push_back({var_id, 0, lookup_tables.size()});
+    lookup_tables.insert(
+        lookup_tables.end(), lookup_table.begin(), lookup_table.end());
+}
+
 
 MergeAndShrinkRepresentationMerge::MergeAndShrinkRepresentationMerge(
     unique_ptr<MergeAndShrinkRepresentation> left_child_,
@@ -161,4 +170,297 @@ void MergeAndShrinkRepresentationMerge::dump(utils::LogProxy &log) const {
         right_child->dump(log);
     }
 }
+
+void MergeAndShrinkRepresentationMerge::append_flat_nodes(
+    vector<FlatRepresentationNode> &nodes, vector<int> &lookup_tables) const {
+    left_child->append_flat_nodes(nodes, lookup_tables);
+    right_child->append_flat_nodes(nodes, lookup_tables);
+    int num_columns = right_child->get_domain_size();
+    nodes.push_back({-1, num_columns, lookup_tables.size()});
+    for (const vector<int> &row : lookup_table) {
+        assert(static_cast<int>(row.size()) == num_columns);
+        lookup_tables.insert(lookup_tables.end(), row.begin(), row.end());
+    }
+}
+
+
+/*
+  Return the maximal number of values on the stack while evaluating the
+  given nodes, or -1 if they are not the post-order of a binary tree.
+*/
+static int compute_max_stack_size(const vector<FlatRepresentationNode> &nodes) {
+    int max_stack_size = 0;
+    int stack_size = 0;
+    for (const FlatRepresentationNode &node : nodes) {
+        if (node.var_id == -1) {
+            if (stack_size < 2) {
+                return -1;
+            }
+            --stack_size;
+        } else {
+            ++stack_size;
+        }
+        max_stack_size = max(max_stack_size, stack_size);
+    }
+    if (stack_size != 1) {
+        return -1;
+    }
+    return max_stack_size;
+}
+
+template<typename T>
+static void write_value(ostream &stream, T value) {
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool read_value(istream &stream, T &value) {
+    return static_cast<bool>(
+        stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+/*
+  Return true if the stream has at least num_items * item_size bytes left.
+  Checking this before allocating memory for counts read from a file keeps
+  corrupt counts from causing huge allocations.
+*/
+static bool has_remaining_bytes(
+    istream &stream, uint64_t num_items, uint64_t item_size) {
+    istream::pos_type position = stream.tellg();
+    if (position == istream::pos_type(-1) ||
+        !stream.seekg(0, ios::end)) {
+        return false;
+    }
+    istream::pos_type end = stream.tellg();
+    stream.seekg(position);
+    if (!stream || end < position) {
+        return false;
+    }
+    uint64_t remaining_bytes = static_cast<uint64_t>(end - position);
+    return num_items <= remaining_bytes / item_size;
+}
+
+/*
+  Check that evaluating the nodes never reads outside of the entries for
+  states whose values lie in the given domains. Every node can only pass
+  values below the largest finite entry of its lookup table plus one to
+  its parent, which bounds the rows and columns of the parent's table.
+*/
+template<typename Entry>
+static bool lookup_tables_are_valid(
+    const vector<FlatRepresentationNode> &nodes, const vector<Entry> &entries,
+    const vector<int> &domain_sizes) {
+    uint64_t num_entries = entries.size();
+    // Number of different values each node on the stack can pass on.
+    vector<uint64_t> stack;
+    for (const FlatRepresentationNode &node : nodes) {
+        uint64_t table_size;
+        if (node.var_id == -1) {
+            uint64_t num_columns = stack.back();
+            stack.pop_back();
+            uint64_t num_rows = stack.back();
+            stack.pop_back();
+            if (node.num_columns <= 0 ||
+                num_columns > static_cast<uint64_t>(node.num_columns)) {
+                return false;
+            }
+            if (num_rows > num_entries / node.num_columns) {
+                return false;
+            }
+            table_size = num_rows * node.num_columns;
+        } else {
+            if (node.var_id < 0 ||
+                node.var_id >= static_cast<int>(domain_sizes.size())) {
+                return false;
+            }
+            table_size = domain_sizes[node.var_id];
+        }
+        if (node.table_offset > num_entries ||
+            table_size > num_entries - node.table_offset) {
+            return false;
+        }
+        uint64_t num_values = 0;
+        for (uint64_t i = 0; i < table_size; ++i) {
+            Entry entry = entries[node.table_offset + i];
+            if (entry != numeric_limits<Entry>::max()) {
+                num_values = max(num_values, static_cast<uint64_t>(entry) + 1);
+            }
+        }
+        stack.push_back(num_values);
+    }
+    return true;
+}
+
+FlatMergeAndShrinkRepresentation::FlatMergeAndShrinkRepresentation(
+    const MergeAndShrinkRepresentation &representation) {
+    vector<int> lookup_tables;
+    representation.append_flat_nodes(nodes, lookup_tables);
+    nodes.shrink_to_fit();
+    max_stack_size = compute_max_stack_size(nodes);
+    assert(max_stack_size != -1);
+
+    int max_entry = 0;
+    for (int entry : lookup_tables) {
+        if (entry != PRUNED_STATE && entry != INF) {
+            max_entry = max(max_entry, entry);
+        }
+    }
+    if (max_entry < numeric_limits<uint8_t>::max()) {
+        set_lookup_tables(lookup_tables, lookup_tables_8);
+    } else if (max_entry < numeric_limits<uint16_t>::max()) {
+        set_lookup_tables(lookup_tables, lookup_tables_16);
+    } else {
+        set_lookup_tables(lookup_tables, lookup_tables_32);
+    }
+}
+
+template<typename Entry>
+void FlatMergeAndShrinkRepresentation::set_lookup_tables(
+    const vector<int> &lookup_tables, vector<Entry> &entries) {
+    entries.reserve(lookup_tables.size());
+    for (int entry : lookup_tables) {
+        if (entry == PRUNED_STATE || entry == INF) {
+            entries.push_back(numeric_limits<Entry>::max());
+        } else {
+            entries.push_back(static_cast<Entry>(entry));
+        }
+    }
+}
+
+template<typename Entry>
+int FlatMergeAndShrinkRepresentation::evaluate(
+    const vector<Entry> &entries, const vector<int> &state_values,
+    vector<int> &stack) const {
+    int stack_size = 0;
+    for (const FlatRepresentationNode &node : nodes) {
+        size_t index = node.table_offset;
+        if (node.var_id == -1) {
+            int right_value = stack[--stack_size];
+            int left_value = stack[--stack_size];
+            index += static_cast<size_t>(left_value) * node.num_columns +
+                right_value;
+        } else {
+            index += state_values[node.var_id];
+        }
+        Entry entry = entries[index];
+        if (entry == numeric_limits<Entry>::max()) {
+            return PRUNED_STATE;
+        }
+        stack[stack_size++] = entry;
+    }
+    assert(stack_size == 1);
+    return stack[0];
+}
+
+int FlatMergeAndShrinkRepresentation::get_value(
+    const vector<int> &state_values, vector<int> &stack) const {
+    assert(static_cast<int>(stack.size()) >= max_stack_size);
+    if (!lookup_tables_8.empty()) {
+        return evaluate(lookup_tables_8, state_values, stack);
+    } else if (!lookup_tables_16.empty()) {
+        return evaluate(lookup_tables_16, state_values, stack);
+    } else {
+        return evaluate(lookup_tables_32, state_values, stack);
+    }
+}
+
+template<typename Entry>
+void FlatMergeAndShrinkRepresentation::write_lookup_tables(
+    ostream &stream, const vector<Entry> &entries) const {
+    write_value<uint32_t>(stream, sizeof(Entry));
+    write_value<uint64_t>(stream, entries.size());
+    stream.write(reinterpret_cast<const char *>(entries.data()),
+                 entries.size() * sizeof(Entry));
+}
+
+void FlatMergeAndShrinkRepresentation::write(ostream &stream) const {
+    /*
+      Format: the number of nodes, the nodes as (var_id, num_columns,
+      table_offset), the number of bytes per entry, the number of entries
+      and the entries.
+    */
+    write_value<uint32_t>(stream, nodes.size());
+    for (const FlatRepresentationNode &node : nodes) {
+        write_value<int32_t>(stream, node.var_id);
+        write_value<int32_t>(stream, node.num_columns);
+        write_value<uint64_t>(stream, node.table_offset);
+    }
+    if (!lookup_tables_8.empty()) {
+        write_lookup_tables(stream, lookup_tables_8);
+    } else if (!lookup_tables_16.empty()) {
+        write_lookup_tables(stream, lookup_tables_16);
+    } else {
+        write_lookup_tables(stream, lookup_tables_32);
+    }
+}
+
+template<typename Entry>
+bool FlatMergeAndShrinkRepresentation::read_lookup_tables(
+    istream &stream, uint64_t num_entries, vector<Entry> &entries,
+    const vector<int> &domain_sizes) const {
+    if (!has_remaining_bytes(stream, num_entries, sizeof(Entry))) {
+        return false;
+    }
+    entries.resize(num_entries);
+    return stream.read(reinterpret_cast<char *>(entries.data()),
+                       num_entries * sizeof(Entry)) &&
+           lookup_tables_are_valid(nodes, entries, domain_sizes);
+}
+
+unique_ptr<FlatMergeAndShrinkRepresentation>
+FlatMergeAndShrinkRepresentation::read(
+    istream &stream, const vector<int> &domain_sizes) {
+    unique_ptr<FlatMergeAndShrinkRepresentation> representation(
+        new FlatMergeAndShrinkRepresentation());
+    uint32_t num_nodes;
+    const uint64_t bytes_per_node =
+        sizeof(int32_t) + sizeof(int32_t) + sizeof(uint64_t);
+    if (!read_value(stream, num_nodes) ||
+        !has_remaining_bytes(stream, num_nodes, bytes_per_node)) {
+        return nullptr;
+    }
+    vector<FlatRepresentationNode> &nodes = representation->nodes;
+    nodes.resize(num_nodes);
+    for (FlatRepresentationNode &node : nodes) {
+        int32_t var_id;
+        int32_t num_columns;
+        uint64_t table_offset;
+        if (!read_value(stream, var_id) || !read_value(stream, num_columns) ||
+            !read_value(stream, table_offset)) {
+            return nullptr;
+        }
+        node = {var_id, num_columns, table_offset};
+    }
+    representation->max_stack_size = compute_max_stack_size(nodes);
+    if (representation->max_stack_size == -1) {
+        return nullptr;
+    }
+
+    uint32_t bytes_per_entry;
+    uint64_t num_entries;
+    if (!read_value(stream, bytes_per_entry) ||
+        !read_value(stream, num_entries)) {
+        return nullptr;
+    }
+    bool success;
+    if (bytes_per_entry == 1) {
+        success = representation->read_lookup_tables(
+            stream, num_entries, representation->lookup_tables_8,
+            domain_sizes);
+    } else if (bytes_per_entry == 2) {
+        success = representation->read_lookup_tables(
+            stream, num_entries, representation->lookup_tables_16,
+            domain_sizes);
+    } else if (bytes_per_entry == 4) {
+        success = representation->read_lookup_tables(
+            stream, num_entries, representation->lookup_tables_32,
+            domain_sizes);
+    } else {
+        success = false;
+    }
+    if (!success) {
+        return nullptr;
+    }
+    return representation;
+}
 }
@@ -1,6 +1,8 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_REPRESENTATION_H
 
+#include <cstdint>
+#include <iosfwd>
 #include <memory>
 #include <vector>
 
@@ -12,6 +14,21 @@ class LogProxy;
 
 namespace merge_and_shrink {
 class Distances;
+
+/*
+  A node of a FlatMergeAndShrinkRepresentation. The lookup table of a leaf
+  is indexed by the value of its variable, the lookup table of a merge node
+  by the values of its two children, one row per value of the left child.
+*/
+struct FlatRepresentationNode {
+    // Variable of a leaf node, or -1 for a merge node.
+    int var_id;
+    // Length of the rows of the lookup table of a merge node.
+    int num_columns;
+    // Position of the lookup table in the array of all lookup tables.
+    std::size_t table_offset;
+};
+
 class MergeAndShrinkRepresentation {
 protected:
     int domain_size;
@@ -37,6 +54,13 @@ public:
        to PRUNED_STATE. */
     virtual bool is_total() const = 0;
     virtual void dump(utils::LogProxy &log) const = 0;
+    /*
+      Append the nodes of the representation in post-order to nodes and
+      their lookup tables to lookup_tables.
+    */
+    virtual void append_flat_nodes(
+        std::vector<FlatRepresentationNode> &nodes,
+        std::vector<int> &lookup_tables) const = 0;
 };
 
 
@@ -54,6 +78,9 @@ public:
     virtual int get_value(const State &state) const override;
     virtual bool is_total() const override;
     virtual void dump(utils::LogProxy &log) const override;
+    virtual void append_flat_nodes(
+        std::vector<FlatRepresentationNode> &nodes,
+        std::vector<int> &lookup_tables) const override;
 };
 
 
@@ -73,6 +100,75 @@ public:
     virtual int get_value(const State &state) const override;
     virtual bool is_total() const override;
     virtual void dump(utils::LogProxy &log) const override;
+    virtual void append_flat_nodes(
+        std::vector<FlatRepresentationNode> &nodes,
+        std::vector<int> &lookup_tables) const override;
+};
+
+
+/*
+  Evaluating the final representations is the hot path of the
+  merge-and-shrink heuristic, so we store all lookup tables of a
+  representation in one array and evaluate its nodes in post-order with
+  an explicit stack instead of recursive virtual calls. The entries use
+  the smallest unsigned integer type that can hold all values; pruned
+  states and infinite distances are stored as the largest value of that
+  type.
+*/
+class FlatMergeAndShrinkRepresentation {
+    std::vector<FlatRepresentationNode> nodes;
+    // Only the lookup tables matching the entry width are non-empty.
+    std::vector<uint8_t> lookup_tables_8;
+    std::vector<uint16_t> lookup_tables_16;
+    std::vector<uint32_t> lookup_tables_32;
+    int max_stack_size;
+
+    FlatMergeAndShrinkRepresentation() = default;
+
+    template<typename Entry>
+    void set_lookup_tables(
+        const std::vector<int> &lookup_tables, std::vector<Entry> &entries);
+    template<typename Entry>
+    int evaluate(
+        const std::vector<Entry> &entries,
+        const std::vector<int> &state_values,
+        std::vector<int> &stack) const;
+    template<typename Entry>
+    void write_lookup_tables(
+        std::ostream &stream, const std::vector<Entry> &entries) const;
+    template<typename Entry>
+    bool read_lookup_tables(
+        std::istream &stream, std::uint64_t num_entries,
+        std::vector<Entry> &entries,
+        const std::vector<int> &domain_sizes) const;
+public:
+    // The representation must store distances (see set_distances).
+    explicit FlatMergeAndShrinkRepresentation(
+        const MergeAndShrinkRepresentation &representation);
+
+    int get_max_stack_size() const {
+        return max_stack_size;
+    }
+
+    /*
+      Return the distance of the state with the given unpacked values, or
+      PRUNED_STATE if the state is pruned or its distance is infinite. The
+      stack is used for the intermediate values and must have at least
+      get_max_stack_size() entries.
+    */
+    int get_value(
+        const std::vector<int> &state_values, std::vector<int> &stack) const;
+
+    // Write the representation in the binary format expected by read().
+    void write(std::ostream &stream) const;
+    /*
+      Read a representation written by write() for a task with the given
+      variable domain sizes. Return nullptr if the stream ends early or
+      does not contain a valid representation, i.e., one whose evaluation
+      could read outside of its lookup tables.
+    */
+    static std::unique_ptr<FlatMergeAndShrinkRepresentation> read(
+        std::istream &stream, const std::vector<int> &domain_sizes);
 };
 }
 
@@ -20,9 +20,15 @@ protected:
 public:
     MergeScoringFunction();
     virtual ~MergeScoringFunction() = default;
+    /*
+      Compute a score for each merge candidate. Implementations may use
+      up to num_threads threads, but the scores must not depend on the
+      number of threads.
+    */
     virtual std::vector<double> compute_scores(
         const FactoredTransitionSystem &fts,
-        const std::vector<std::pair<int, int>> &merge_candidates) = 0;
+        const std::vector<std::pair<int, int>> &merge_candidates,
+        int num_threads) = 0;
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
 
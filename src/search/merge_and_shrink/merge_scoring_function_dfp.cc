@@ -7,6 +7,7 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/markup.h"
+#include "../utils/parallel.h"
 
 #include <cassert>
 
@@ -24,7 +25,7 @@ vector<int> MergeScoringFunctionDFP::compute_label_ranks(
 
     for (const LocalLabelInfo &local_label_info : ts) {
         const LabelGroup &label_group = local_label_info.get_label_group();
-        const vector<Transition> &transitions = local_label_info.get_transitions();
+        TransitionRange transitions = ts.get_transitions(local_label_info);
         // Relevant labels with no transitions have a rank of infinity.
         int label_rank = INF;
         bool group_relevant = false;
@@ -60,39 +61,53 @@ vector<int> MergeScoringFunctionDFP::compute_label_ranks(
 
 vector<double> MergeScoringFunctionDFP::compute_scores(
     const FactoredTransitionSystem &fts,
-    const vector<pair<int, int>> &merge_candidates) {
+    const vector<pair<int, int>> &merge_candidates,
+    int num_threads) {
     int num_ts = fts.get_size();
 
+    // Compute the label ranks of all transition systems that are merge candidates.
+    vector<bool> is_candidate(num_ts, false);
+    for (pair<int, int> merge_candidate : merge_candidates) {
+        is_candidate[merge_candidate.first] = true;
+        is_candidate[merge_candidate.second] = true;
+    }
+    vector<int> candidate_indices;
+    for (int ts_index = 0; ts_index < num_ts; ++ts_index) {
+        if (is_candidate[ts_index]) {
+            candidate_indices.push_back(ts_index);
+        }
+    }
     vector<vector<int>> transition_system_label_ranks(num_ts);
-    vector<double> scores;
-    scores.reserve(merge_candidates.size());
+    utils::parallel_for(
+        candidate_indices.size(), num_threads,
+        [&](int i) {
+            int ts_index = candidate_indices[i];
+            transition_system_label_ranks[ts_index] =
+                compute_label_ranks(fts, ts_index);
+        });
 
     // Go over all pairs of transition systems and compute their weight.
-    for (pair<int, int> merge_candidate : merge_candidates) {
-        int ts_index1 = merge_candidate.first;
-        int ts_index2 = merge_candidate.second;
-
-        vector<int> &label_ranks1 = transition_system_label_ranks[ts_index1];
-        if (label_ranks1.empty()) {
-            label_ranks1 = compute_label_ranks(fts, ts_index1);
-        }
-        vector<int> &label_ranks2 = transition_system_label_ranks[ts_index2];
-        if (label_ranks2.empty()) {
-            label_ranks2 = compute_label_ranks(fts, ts_index2);
-        }
-        assert(label_ranks1.size() == label_ranks2.size());
-
-        // Compute the weight associated with this pair
-        int pair_weight = INF;
-        for (size_t i = 0; i < label_ranks1.size(); ++i) {
-            if (label_ranks1[i] != -1 && label_ranks2[i] != -1) {
-                // label is relevant in both transition_systems
-                int max_label_rank = max(label_ranks1[i], label_ranks2[i]);
-                pair_weight = min(pair_weight, max_label_rank);
+    vector<double> scores(merge_candidates.size());
+    utils::parallel_for(
+        merge_candidates.size(), num_threads,
+        [&](int candidate_index) {
+            const vector<int> &label_ranks1 =
+                transition_system_label_ranks[merge_candidates[candidate_index].first];
+            const vector<int> &label_ranks2 =
+                transition_system_label_ranks[merge_candidates[candidate_index].second];
+            assert(label_ranks1.size() == label_ranks2.size());
+
+            // Compute the weight associated with this pair
+            int pair_weight = INF;
+            for (size_t i = 0; i < label_ranks1.size(); ++i) {
+                if (label_ranks1[i] != -1 && label_ranks2[i] != -1) {
+                    // label is relevant in both transition_systems
+                    int max_label_rank = max(label_ranks1[i], label_ranks2[i]);
+                    pair_weight = min(pair_weight, max_label_rank);
+                }
             }
-        }
-        scores.push_back(pair_weight);
-    }
+            scores[candidate_index] = pair_weight;
+        });
     return scores;
 }
 
@@ -14,7 +14,8 @@ public:
     virtual ~MergeScoringFunctionDFP() override = default;
     virtual std::vector<double> compute_scores(
         const FactoredTransitionSystem &fts,
-        const std::vector<std::pair<int, int>> &merge_candidates) override;
+        const std::vector<std::pair<int, int>> &merge_candidates,
+        int num_threads) override;
 
     virtual bool requires_init_distances() const override {
         return false;
@@ -10,6 +10,7 @@
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/parallel.h"
 
 using namespace std;
 
@@ -23,46 +24,67 @@ MergeScoringFunctionMIASM::MergeScoringFunctionMIASM(
       silent_log(utils::get_silent_log()) {
 }
 
-vector<double> MergeScoringFunctionMIASM::compute_scores(
-    const FactoredTransitionSystem &fts,
-    const vector<pair<int, int>> &merge_candidates) {
-    vector<double> scores;
-    scores.reserve(merge_candidates.size());
-    for (pair<int, int> merge_candidate : merge_candidates) {
-        int index1 = merge_candidate.first;
-        int index2 = merge_candidate.second;
-        unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
-            fts,
-            index1,
-            index2,
-            *shrink_strategy,
-            max_states,
-            max_states_before_merge,
-            shrink_threshold_before_merge,
-            silent_log);
+double MergeScoringFunctionMIASM::compute_score(
+    const FactoredTransitionSystem &fts, int index1, int index2,
+    utils::LogProxy &log) const {
+    unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
+        fts,
+        index1,
+        index2,
+        *shrink_strategy,
+        max_states,
+        max_states_before_merge,
+        shrink_threshold_before_merge,
+        log);
 
-        // Compute distances for the product and count the alive states.
-        unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
-        const bool compute_init_distances = true;
-        const bool compute_goal_distances = true;
-        distances->compute_distances(compute_init_distances, compute_goal_distances, silent_log);
-        int num_states = product->get_size();
-        int alive_states_count = 0;
-        for (int state = 0; state < num_states; ++state) {
-            if (distances->get_init_distance(state) != INF &&
-                distances->get_goal_distance(state) != INF) {
-                ++alive_states_count;
-            }
+    // Compute distances for the product and count the alive states.
+    unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
+    const bool compute_init_distances = true;
+    const bool compute_goal_distances = true;
+    distances->compute_distances(compute_init_distances, compute_goal_distances, log);
+    int num_states = product->get_size();
+    int alive_states_count = 0;
+    for (int state = 0; state < num_states; ++state) {
+        if (distances->get_init_distance(state) != INF &&
+            distances->get_goal_distance(state) != INF) {
+            ++alive_states_count;
         }
+    }
+
+    /*
+      Compute the score as the ratio of alive states of the product
+      compared to the number of states of the full product.
+    */
+    assert(num_states);
+    return static_cast<double>(alive_states_count) /
+           static_cast<double>(num_states);
+}
 
+vector<double> MergeScoringFunctionMIASM::compute_scores(
+    const FactoredTransitionSystem &fts,
+    const vector<pair<int, int>> &merge_candidates,
+    int num_threads) {
+    vector<double> scores(merge_candidates.size());
+    if (num_threads <= 1 || !shrink_strategy->is_thread_safe()) {
+        for (size_t i = 0; i < merge_candidates.size(); ++i) {
+            scores[i] = compute_score(
+                fts, merge_candidates[i].first, merge_candidates[i].second,
+                silent_log);
+        }
+    } else {
         /*
-          Compute the score as the ratio of alive states of the product
-          compared to the number of states of the full product.
+          Each candidate builds its product from copies of the transition
+          systems, so the factored transition system is only read. Logs
+          are not thread-safe, so each candidate gets its own.
         */
-        assert(num_states);
-        double score = static_cast<double>(alive_states_count) /
-            static_cast<double>(num_states);
-        scores.push_back(score);
+        utils::parallel_for(
+            merge_candidates.size(), num_threads,
+            [&](int i) {
+                utils::LogProxy log = utils::get_silent_log();
+                scores[i] = compute_score(
+                    fts, merge_candidates[i].first, merge_candidates[i].second,
+                    log);
+            });
     }
     return scores;
 }
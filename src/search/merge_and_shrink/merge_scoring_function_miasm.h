@@ -15,6 +15,10 @@ class MergeScoringFunctionMIASM : public MergeScoringFunction {
     const int max_states_before_merge;
     const int shrink_threshold_before_merge;
     utils::LogProxy silent_log;
+
+    double compute_score(
+        const FactoredTransitionSystem &fts, int index1, int index2,
+        utils::LogProxy &log) const;
 protected:
     virtual std::string name() const override;
 public:
@@ -22,7 +26,8 @@ public:
     virtual ~MergeScoringFunctionMIASM() override = default;
     virtual std::vector<double> compute_scores(
         const FactoredTransitionSystem &fts,
-        const std::vector<std::pair<int, int>> &merge_candidates) override;
+        const std::vector<std::pair<int, int>> &merge_candidates,
+        int num_threads) override;
 
     virtual bool requires_init_distances() const override {
         return true;
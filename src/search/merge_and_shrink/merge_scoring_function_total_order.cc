@@ -27,7 +27,8 @@ MergeScoringFunctionTotalOrder::MergeScoringFunctionTotalOrder(
 
 vector<double> MergeScoringFunctionTotalOrder::compute_scores(
     const FactoredTransitionSystem &,
-    const vector<pair<int, int>> &merge_candidates) {
+    const vector<pair<int, int>> &merge_candidates,
+    int) {
     assert(initialized);
     vector<double> scores;
     scores.reserve(merge_candidates.size());
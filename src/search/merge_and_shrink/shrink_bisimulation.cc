@@ -8,6 +8,7 @@
 #include "../utils/collections.h"
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
 #include <algorithm>
@@ -15,6 +16,7 @@
 #include <limits>
 #include <iostream>
 #include <memory>
+#include <numeric>
 #include <unordered_map>
 
 using namespace std;
@@ -53,9 +55,9 @@ struct Signature {
     int state;
 
     Signature(int h, bool is_goal, int group_,
-              const SuccessorSignature &succ_signature_,
+              SuccessorSignature &&succ_signature_,
               int state_)
-        : group(group_), succ_signature(succ_signature_), state(state_) {
+        : group(group_), succ_signature(move(succ_signature_)), state(state_) {
         if (is_goal) {
             assert(h == 0);
             h_and_goal = -1;
@@ -93,9 +95,23 @@ struct Signature {
 };
 
 
+/*
+  The outgoing transitions of all states that are relevant for
+  bisimulation as pairs of (label group ID, target state), grouped by
+  source state: the transitions of state s are
+  successors[offsets[s]], ..., successors[offsets[s + 1] - 1].
+*/
+struct LabeledSuccessors {
+    vector<int> offsets;
+    vector<pair<int, int>> successors;
+};
+
+
 ShrinkBisimulation::ShrinkBisimulation(const plugins::Options &opts)
     : greedy(opts.get<bool>("greedy")),
-      at_limit(opts.get<AtLimit>("at_limit")) {
+      at_limit(opts.get<AtLimit>("at_limit")),
+      refinement(opts.get<RefinementAlgorithm>("refinement")),
+      num_threads(opts.get<int>("threads")) {
 }
 
 int ShrinkBisimulation::initialize_groups(
@@ -136,28 +152,14 @@ int ShrinkBisimulation::initialize_groups(
     return num_groups;
 }
 
-void ShrinkBisimulation::compute_signatures(
+void ShrinkBisimulation::compute_labeled_successors(
     const TransitionSystem &ts,
     const Distances &distances,
-    vector<Signature> &signatures,
-    const vector<int> &state_to_group) const {
-    assert(signatures.empty());
-
-    // Step 1: Compute bare state signatures (without transition information).
-    signatures.push_back(Signature(-2, false, -1, SuccessorSignature(), -1));
-    for (int state = 0; state < ts.get_size(); ++state) {
-        int h = distances.get_goal_distance(state);
-        if (h == INF) {
-            h = IRRELEVANT;
-        }
-        Signature signature(h, ts.is_goal_state(state),
-                            state_to_group[state], SuccessorSignature(),
-                            state);
-        signatures.push_back(signature);
-    }
-    signatures.push_back(Signature(SENTINEL, false, -1, SuccessorSignature(), -1));
+    LabeledSuccessors &successors) const {
+    int num_states = ts.get_size();
+    vector<int> &offsets = successors.offsets;
+    offsets.assign(num_states + 1, 0);
 
-    // Step 2: Add transition information.
     int label_group_counter = 0;
     /*
       Note that the final result of the bisimulation may depend on the
@@ -183,35 +185,74 @@ void ShrinkBisimulation::compute_signatures(
                                                 threshold=1),
             label_reduction=exact(before_shrinking=true,before_merging=false)))
     */
+    auto is_relevant = [&](const LocalLabelInfo &local_label_info,
+                           const Transition &transition) {
+            if (!greedy) {
+                return true;
+            }
+            int src_h = distances.get_goal_distance(transition.src);
+            int target_h = distances.get_goal_distance(transition.target);
+            if (src_h == INF || target_h == INF) {
+                // We skip transitions connected to an irrelevant state.
+                return false;
+            }
+            int cost = local_label_info.get_cost();
+            assert(target_h + cost >= src_h);
+            return target_h + cost == src_h;
+        };
+
+    // Count the relevant transitions of each state.
     for (const LocalLabelInfo &local_label_info : ts) {
-        const vector<Transition> &transitions = local_label_info.get_transitions();
-        for (const Transition &transition : transitions) {
-            assert(signatures[transition.src + 1].state == transition.src);
-            bool skip_transition = false;
-            if (greedy) {
-                int src_h = distances.get_goal_distance(transition.src);
-                int target_h = distances.get_goal_distance(transition.target);
-                if (src_h == INF || target_h == INF) {
-                    // We skip transitions connected to an irrelevant state.
-                    skip_transition = true;
-                } else {
-                    int cost = local_label_info.get_cost();
-                    assert(target_h + cost >= src_h);
-                    skip_transition = (target_h + cost != src_h);
-                }
+        for (const Transition &transition : ts.get_transitions(local_label_info)) {
+            if (is_relevant(local_label_info, transition)) {
+                ++offsets[transition.src + 1];
             }
-            if (!skip_transition) {
-                int target_group = state_to_group[transition.target];
-                assert(target_group != -1 && target_group != SENTINEL);
-                signatures[transition.src + 1].succ_signature.push_back(
-                    make_pair(label_group_counter, target_group));
+        }
+    }
+    for (int state = 0; state < num_states; ++state) {
+        offsets[state + 1] += offsets[state];
+    }
+
+    successors.successors.resize(offsets[num_states]);
+    vector<int> next_position(offsets.begin(), offsets.end() - 1);
+    for (const LocalLabelInfo &local_label_info : ts) {
+        for (const Transition &transition : ts.get_transitions(local_label_info)) {
+            if (is_relevant(local_label_info, transition)) {
+                successors.successors[next_position[transition.src]++] =
+                    make_pair(label_group_counter, transition.target);
             }
         }
         ++label_group_counter;
     }
+}
+
+void ShrinkBisimulation::compute_signatures(
+    const TransitionSystem &ts,
+    const Distances &distances,
+    const LabeledSuccessors &successors,
+    const vector<int> &state_to_group,
+    int num_groups,
+    vector<Signature> &signatures) const {
+    int num_states = ts.get_size();
+    vector<int> h_and_goal(num_states);
+    for (int state = 0; state < num_states; ++state) {
+        if (ts.is_goal_state(state)) {
+            h_and_goal[state] = -1;
+        } else {
+            int h = distances.get_goal_distance(state);
+            h_and_goal[state] = (h == INF) ? IRRELEVANT : h;
+        }
+    }
+
+    /*
+      Signature::operator< orders by h value, group, successor signature
+      and state, and all states of a group have the same h value. We
+      therefore place the states of each group in a contiguous range, with
+      the groups ordered by h value and group number, and then only sort
+      the signatures within each group. The result is the same as sorting
+      all signatures, but the groups can be handled by different threads.
 
-    /* Step 3: Canonicalize the representation. The resulting
-       signatures must satisfy the following properties:
+      The resulting signatures must satisfy the following properties:
 
        1. Signature::operator< defines a total order with the correct
           sentinels at the start and end. The signatures vector is
@@ -223,48 +264,93 @@ void ShrinkBisimulation::compute_signatures(
        4. Two signatures compare equal according to Signature::operator<
           iff we don't want to distinguish their states in the current
           bisimulation round.
-     */
-
-    for (size_t i = 0; i < signatures.size(); ++i) {
-        SuccessorSignature &succ_sig = signatures[i].succ_signature;
-        ::sort(succ_sig.begin(), succ_sig.end());
-        succ_sig.erase(::unique(succ_sig.begin(), succ_sig.end()),
-                       succ_sig.end());
+    */
+    vector<int> group_h_and_goal(num_groups, 0);
+    vector<int> group_size(num_groups, 0);
+    for (int state = 0; state < num_states; ++state) {
+        int group = state_to_group[state];
+        group_h_and_goal[group] = h_and_goal[state];
+        ++group_size[group];
+    }
+    vector<int> group_order(num_groups);
+    iota(group_order.begin(), group_order.end(), 0);
+    sort(group_order.begin(), group_order.end(),
+         [&](int group1, int group2) {
+             return make_pair(group_h_and_goal[group1], group1) <
+                    make_pair(group_h_and_goal[group2], group2);
+         });
+    // Position 0 holds the initial sentinel.
+    vector<int> group_begin(num_groups);
+    int position = 1;
+    for (int group : group_order) {
+        group_begin[group] = position;
+        position += group_size[group];
+    }
+    vector<int> state_position(num_states);
+    vector<int> next_position(group_begin);
+    for (int state = 0; state < num_states; ++state) {
+        state_position[state] = next_position[state_to_group[state]]++;
     }
 
-    ::sort(signatures.begin(), signatures.end());
+    signatures.clear();
+    signatures.reserve(num_states + 2);
+    for (int i = 0; i < num_states + 1; ++i) {
+        signatures.emplace_back(-2, false, -1, SuccessorSignature(), -1);
+    }
+    signatures.emplace_back(SENTINEL, false, -1, SuccessorSignature(), -1);
+
+    utils::parallel_for(
+        num_states, num_threads,
+        [&](int state) {
+            SuccessorSignature succ_signature;
+            succ_signature.reserve(
+                successors.offsets[state + 1] - successors.offsets[state]);
+            for (int i = successors.offsets[state];
+                 i < successors.offsets[state + 1]; ++i) {
+                const pair<int, int> &successor = successors.successors[i];
+                int target_group = state_to_group[successor.second];
+                assert(target_group != -1 && target_group != SENTINEL);
+                succ_signature.emplace_back(successor.first, target_group);
+            }
+            ::sort(succ_signature.begin(), succ_signature.end());
+            succ_signature.erase(
+                ::unique(succ_signature.begin(), succ_signature.end()),
+                succ_signature.end());
+            int h = (h_and_goal[state] == -1) ? 0 : h_and_goal[state];
+            signatures[state_position[state]] = Signature(
+                h, ts.is_goal_state(state), state_to_group[state],
+                move(succ_signature), state);
+        });
+
+    utils::parallel_for(
+        num_groups, num_threads,
+        [&](int group) {
+            auto first = signatures.begin() + group_begin[group];
+            ::sort(first, first + group_size[group]);
+        });
 }
 
-StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
+int ShrinkBisimulation::refine_by_signatures(
     const TransitionSystem &ts,
     const Distances &distances,
+    const LabeledSuccessors &successors,
     int target_size,
-    utils::LogProxy &) const {
-    assert(distances.are_goal_distances_computed());
-    int num_states = ts.get_size();
-
-    vector<int> state_to_group(num_states);
+    vector<int> &state_to_group,
+    int num_groups) const {
     vector<Signature> signatures;
-    signatures.reserve(num_states + 2);
-
-    int num_groups = initialize_groups(ts, distances, state_to_group);
-    // log << "number of initial groups: " << num_groups << endl;
-
-    // TODO: We currently violate this; see issue250
-    // assert(num_groups <= target_size);
 
     bool stable = false;
     bool stop_requested = false;
     while (!stable && !stop_requested && num_groups < target_size) {
         stable = true;
 
-        signatures.clear();
-        compute_signatures(ts, distances, signatures, state_to_group);
+        compute_signatures(ts, distances, successors, state_to_group,
+                           num_groups, signatures);
 
         // Verify size of signatures and presence of sentinels.
-        assert(static_cast<int>(signatures.size()) == num_states + 2);
+        assert(static_cast<int>(signatures.size()) == ts.get_size() + 2);
         assert(signatures[0].h_and_goal == -2);
-        assert(signatures[num_states + 1].h_and_goal == SENTINEL);
+        assert(signatures.back().h_and_goal == SENTINEL);
 
         int sig_start = 1; // Skip over initial sentinel.
         while (true) {
@@ -338,10 +424,183 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
         }
     }
 
+    return num_groups;
+}
+
+int ShrinkBisimulation::refine_by_partition_refinement(
+    int num_states,
+    const LabeledSuccessors &successors,
+    int target_size,
+    vector<int> &state_to_group,
+    int num_groups) const {
+    if (num_groups > target_size) {
+        return -1;
+    }
+
+    // Incoming transitions as pairs of (label group ID, source state).
+    vector<int> pred_offsets(num_states + 1, 0);
+    for (const pair<int, int> &successor : successors.successors) {
+        ++pred_offsets[successor.second + 1];
+    }
+    for (int state = 0; state < num_states; ++state) {
+        pred_offsets[state + 1] += pred_offsets[state];
+    }
+    vector<pair<int, int>> predecessors(successors.successors.size());
+    vector<int> next_pred_position(pred_offsets.begin(), pred_offsets.end() - 1);
+    for (int src = 0; src < num_states; ++src) {
+        for (int i = successors.offsets[src]; i < successors.offsets[src + 1]; ++i) {
+            const pair<int, int> &successor = successors.successors[i];
+            predecessors[next_pred_position[successor.second]++] =
+                make_pair(successor.first, src);
+        }
+    }
+    utils::release_vector_memory(next_pred_position);
+
+    /*
+      The states of each block form the contiguous range
+      elements[block_begin[b]], ..., elements[block_end[b] - 1]. While
+      splitting, the marked states of block b are moved to the front of
+      its range, which ends at block_marked_end[b].
+    */
+    vector<int> block_of(state_to_group);
+    vector<int> block_begin(num_groups, 0);
+    for (int state = 0; state < num_states; ++state) {
+        ++block_begin[block_of[state]];
+    }
+    int position = 0;
+    for (int block = 0; block < num_groups; ++block) {
+        int size = block_begin[block];
+        block_begin[block] = position;
+        position += size;
+    }
+    vector<int> block_end(block_begin);
+    vector<int> elements(num_states);
+    vector<int> location(num_states);
+    for (int state = 0; state < num_states; ++state) {
+        int pos = block_end[block_of[state]]++;
+        elements[pos] = state;
+        location[state] = pos;
+    }
+    vector<int> block_marked_end(block_begin);
+
+    // Blocks that still have to be used as splitters.
+    vector<int> worklist(num_groups);
+    iota(worklist.begin(), worklist.end(), 0);
+    vector<bool> in_worklist(num_groups, true);
+
+    vector<pair<int, int>> splitter_predecessors;
+    vector<int> touched_blocks;
+    while (!worklist.empty()) {
+        int splitter = worklist.back();
+        worklist.pop_back();
+        in_worklist[splitter] = false;
+
+        splitter_predecessors.clear();
+        for (int pos = block_begin[splitter]; pos < block_end[splitter]; ++pos) {
+            int state = elements[pos];
+            splitter_predecessors.insert(
+                splitter_predecessors.end(),
+                predecessors.begin() + pred_offsets[state],
+                predecessors.begin() + pred_offsets[state + 1]);
+        }
+        utils::sort_unique(splitter_predecessors);
+
+        /*
+          For each label group, split every block into the states with
+          and without a transition with that label group into the splitter.
+        */
+        size_t i = 0;
+        while (i < splitter_predecessors.size()) {
+            int label_group = splitter_predecessors[i].first;
+            touched_blocks.clear();
+            for (; i < splitter_predecessors.size() &&
+                 splitter_predecessors[i].first == label_group; ++i) {
+                int src = splitter_predecessors[i].second;
+                int block = block_of[src];
+                if (block_marked_end[block] == block_begin[block]) {
+                    touched_blocks.push_back(block);
+                }
+                int pos = location[src];
+                int marked_pos = block_marked_end[block]++;
+                int other = elements[marked_pos];
+                elements[pos] = other;
+                location[other] = pos;
+                elements[marked_pos] = src;
+                location[src] = marked_pos;
+            }
+
+            for (int block : touched_blocks) {
+                int marked_end = block_marked_end[block];
+                block_marked_end[block] = block_begin[block];
+                if (marked_end == block_end[block]) {
+                    // All states of the block are marked.
+                    continue;
+                }
+                int new_block = block_begin.size();
+                if (new_block == target_size) {
+                    return -1;
+                }
+                block_begin.push_back(block_begin[block]);
+                block_end.push_back(marked_end);
+                block_marked_end.push_back(block_begin[block]);
+                block_begin[block] = marked_end;
+                block_marked_end[block] = marked_end;
+                for (int pos = block_begin[new_block]; pos < marked_end; ++pos) {
+                    block_of[elements[pos]] = new_block;
+                }
+                worklist.push_back(new_block);
+                in_worklist.push_back(true);
+                if (!in_worklist[block]) {
+                    worklist.push_back(block);
+                    in_worklist[block] = true;
+                }
+            }
+        }
+    }
+
+    state_to_group = move(block_of);
+    return block_begin.size();
+}
+
+StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
+    const TransitionSystem &ts,
+    const Distances &distances,
+    int target_size,
+    utils::LogProxy &) const {
+    assert(distances.are_goal_distances_computed());
+    int num_states = ts.get_size();
+
+    vector<int> state_to_group(num_states);
+    int num_groups = initialize_groups(ts, distances, state_to_group);
+    // log << "number of initial groups: " << num_groups << endl;
+
+    // TODO: We currently violate this; see issue250
+    // assert(num_groups <= target_size);
+
+    LabeledSuccessors successors;
+    compute_labeled_successors(ts, distances, successors);
+
+    int num_refined_groups = -1;
+    if (refinement == RefinementAlgorithm::PARTITION_REFINEMENT) {
+        num_refined_groups = refine_by_partition_refinement(
+            num_states, successors, target_size, state_to_group, num_groups);
+    }
+    if (num_refined_groups == -1) {
+        /*
+          If the bisimulation exceeds the size limit, the signature-based
+          refinement decides which groups to split (see at_limit).
+        */
+        num_refined_groups = refine_by_signatures(
+            ts, distances, successors, target_size, state_to_group,
+            num_groups);
+    }
+    num_groups = num_refined_groups;
+
     /* Reduce memory pressure before generating the equivalence
        relation since this is one of the code parts relevant to peak
        memory. */
-    utils::release_vector_memory(signatures);
+    utils::release_vector_memory(successors.offsets);
+    utils::release_vector_memory(successors.successors);
 
     // Generate final result.
     StateEquivalenceRelation equivalence_relation;
@@ -373,6 +632,16 @@ void ShrinkBisimulation::dump_strategy_specific_options(utils::LogProxy &log) co
             ABORT("Unknown setting for at_limit.");
         }
         log << endl;
+        log << "Refinement: ";
+        if (refinement == RefinementAlgorithm::SIGNATURES) {
+            log << "signatures";
+        } else if (refinement == RefinementAlgorithm::PARTITION_REFINEMENT) {
+            log << "partition refinement";
+        } else {
+            ABORT("Unknown setting for refinement.");
+        }
+        log << endl;
+        log << "Threads: " << num_threads << endl;
     }
 }
 
@@ -397,6 +666,19 @@ public:
         add_option<AtLimit>(
             "at_limit",
             "what to do when the size limit is hit", "return");
+        add_option<RefinementAlgorithm>(
+            "refinement",
+            "algorithm for refining the initial groups into the bisimulation",
+            "signatures");
+        add_option<int>(
+            "threads",
+            "number of threads for computing and sorting the successor "
+            "signatures. The resulting abstraction does not depend on the "
+            "number of threads. When the shrink strategy is used by a merge "
+            "scoring function that runs in parallel (see "
+            "{{{score_based_filtering}}}), it uses one thread.",
+            "1",
+            plugins::Bounds("1", "infinity"));
 
         document_note(
             "shrink_bisimulation(greedy=true)",
@@ -431,4 +713,16 @@ static plugins::TypedEnumPlugin<AtLimit> _enum_plugin({
          "continue refining the equivalence class until "
          "the size limit is hit"}
     });
+
+static plugins::TypedEnumPlugin<RefinementAlgorithm> _refinement_enum_plugin({
+        {"signatures",
+         "repeatedly split all groups by the successor signatures of their "
+         "states"},
+        {"partition_refinement",
+         "split groups by the predecessors of one splitter group at a time "
+         "(Paige-Tarjan style), which only touches the states affected by a "
+         "split. If the bisimulation exceeds the size limit, this falls back "
+         "to signatures, so the resulting groups are the same up to their "
+         "numbering. The threads option is ignored in this case."}
+    });
 }
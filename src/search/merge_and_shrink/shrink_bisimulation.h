@@ -8,6 +8,7 @@ class Options;
 }
 
 namespace merge_and_shrink {
+struct LabeledSuccessors;
 struct Signature;
 
 enum class AtLimit {
@@ -15,9 +16,16 @@ enum class AtLimit {
     USE_UP
 };
 
+enum class RefinementAlgorithm {
+    SIGNATURES,
+    PARTITION_REFINEMENT
+};
+
 class ShrinkBisimulation : public ShrinkStrategy {
     const bool greedy;
     const AtLimit at_limit;
+    const RefinementAlgorithm refinement;
+    const int num_threads;
 
     void compute_abstraction(
         const TransitionSystem &ts,
@@ -30,11 +38,44 @@ class ShrinkBisimulation : public ShrinkStrategy {
         const Distances &distances,
         std::vector<int> &state_to_group) const;
 
+    void compute_labeled_successors(
+        const TransitionSystem &ts,
+        const Distances &distances,
+        LabeledSuccessors &successors) const;
+
     void compute_signatures(
         const TransitionSystem &ts,
         const Distances &distances,
-        std::vector<Signature> &signatures,
-        const std::vector<int> &state_to_group) const;
+        const LabeledSuccessors &successors,
+        const std::vector<int> &state_to_group,
+        int num_groups,
+        std::vector<Signature> &signatures) const;
+
+    /*
+      Refine the groups by splitting groups with different successor
+      signatures until the groups are stable or the size limit is
+      reached. Returns the new number of groups.
+    */
+    int refine_by_signatures(
+        const TransitionSystem &ts,
+        const Distances &distances,
+        const LabeledSuccessors &successors,
+        int target_size,
+        std::vector<int> &state_to_group,
+        int num_groups) const;
+
+    /*
+      Refine the groups to the coarsest bisimulation by splitting groups
+      with respect to the predecessors of other groups. Returns the new
+      number of groups, or -1 without changing state_to_group if the
+      bisimulation has more than target_size groups.
+    */
+    int refine_by_partition_refinement(
+        int num_states,
+        const LabeledSuccessors &successors,
+        int target_size,
+        std::vector<int> &state_to_group,
+        int num_groups) const;
 protected:
     virtual void dump_strategy_specific_options(utils::LogProxy &log) const override;
     virtual std::string name() const override;
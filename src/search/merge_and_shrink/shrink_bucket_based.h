@@ -58,6 +58,10 @@ public:
         const Distances &distances,
         int target_size,
         utils::LogProxy &log) const override;
+    // The random number generator is shared between all calls.
+    virtual bool is_thread_safe() const override {
+        return false;
+    }
     static void add_options_to_feature(plugins::Feature &feature);
 };
 }
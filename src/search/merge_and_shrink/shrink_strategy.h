@@ -44,6 +44,14 @@ public:
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
 
+    /*
+      Return true if compute_equivalence_relation may be called for
+      different transition systems from several threads at the same time.
+    */
+    virtual bool is_thread_safe() const {
+        return true;
+    }
+
     void dump_options(utils::LogProxy &log) const;
     std::string get_name() const;
 };
@@ -59,15 +59,9 @@ void LocalLabelInfo::recompute_cost(const Labels &labels) {
     }
 }
 
-void LocalLabelInfo::replace_transitions(vector<Transition> &&new_transitions) {
-    transitions = move(new_transitions);
-    assert(is_consistent());
-}
-
 void LocalLabelInfo::merge_local_label_info(LocalLabelInfo &local_label_info) {
     assert(is_consistent());
     assert(local_label_info.is_consistent());
-    assert(transitions == local_label_info.transitions);
     label_group.insert(
         label_group.end(),
         make_move_iterator(local_label_info.label_group.begin()),
@@ -79,14 +73,14 @@ void LocalLabelInfo::merge_local_label_info(LocalLabelInfo &local_label_info) {
 }
 
 void LocalLabelInfo::deactivate() {
-    utils::release_vector_memory(transitions);
     utils::release_vector_memory(label_group);
+    transitions_end = transitions_begin;
     cost = -1;
 }
 
 bool LocalLabelInfo::is_consistent() const {
     return utils::is_sorted_unique(label_group) &&
-           utils::is_sorted_unique(transitions);
+           transitions_begin <= transitions_end;
 }
 
 
@@ -122,6 +116,11 @@ TransitionSystemConstIterator &TransitionSystemConstIterator::operator++() {
   transitions itself. Various experiments have shown that maintaining
   a graph representation permanently for the benefit of distance
   computation is not worth the overhead.
+
+  The transitions of all local labels share one array, so that a
+  transition system only needs two allocations for its transitions
+  (the array and the local labels) and abstractions can be applied in
+  place.
 */
 
 TransitionSystem::TransitionSystem(
@@ -130,6 +129,7 @@ TransitionSystem::TransitionSystem(
     const Labels &labels,
     vector<int> &&label_to_local_label,
     vector<LocalLabelInfo> &&local_label_infos,
+    vector<Transition> &&transitions,
     int num_states,
     vector<bool> &&goal_states,
     int init_state)
@@ -138,6 +138,7 @@ TransitionSystem::TransitionSystem(
       labels(move(labels)),
       label_to_local_label(move(label_to_local_label)),
       local_label_infos(move(local_label_infos)),
+      transitions(move(transitions)),
       num_states(num_states),
       goal_states(move(goal_states)),
       init_state(init_state) {
@@ -150,6 +151,7 @@ TransitionSystem::TransitionSystem(const TransitionSystem &other)
       labels(other.labels),
       label_to_local_label(other.label_to_local_label),
       local_label_infos(other.local_label_infos),
+      transitions(other.transitions),
       num_states(other.num_states),
       goal_states(other.goal_states),
       init_state(other.init_state) {
@@ -208,12 +210,24 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     */
     int multiplier = ts2_size;
     LabelGroup dead_labels;
+
+    /*
+      First distribute the labels of each group of ts1 among the "buckets"
+      corresponding to the groups of ts2 and count the transitions of the
+      product, so that the transitions can be stored in a single allocation.
+    */
+    struct ProductLabelGroup {
+        TransitionRange transitions1;
+        TransitionRange transitions2;
+        LabelGroup labels;
+    };
+    vector<ProductLabelGroup> product_label_groups;
+    size_t num_transitions = 0;
+    size_t max_num_transitions = vector<Transition>().max_size();
     for (const LocalLabelInfo &local_label_info : ts1) {
         const LabelGroup &group1 = local_label_info.get_label_group();
-        const vector<Transition> &transitions1 = local_label_info.get_transitions();
+        TransitionRange transitions1 = ts1.get_transitions(local_label_info);
 
-        // Distribute the labels of this group among the "buckets"
-        // corresponding to the groups of ts2.
         unordered_map<int, LabelGroup> buckets;
         for (int label : group1) {
             int ts_local_label2 = ts2.label_to_local_label[label];
@@ -222,47 +236,54 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         // Now buckets contains all equivalence classes that are
         // refinements of group1.
 
-        // Now create the new groups together with their transitions.
         for (auto &bucket : buckets) {
-            const vector<Transition> &transitions2 =
-                ts2.local_label_infos[bucket.first].get_transitions();
-
-            // Create the new transitions for this bucket
-            vector<Transition> new_transitions;
-            if (!transitions1.empty() && !transitions2.empty()
-                && transitions1.size() > new_transitions.max_size() / transitions2.size())
-                utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
-            new_transitions.reserve(transitions1.size() * transitions2.size());
-            for (const Transition &transition1 : transitions1) {
-                int src1 = transition1.src;
-                int target1 = transition1.target;
-                for (const Transition &transition2 : transitions2) {
-                    int src2 = transition2.src;
-                    int target2 = transition2.target;
-                    int src = src1 * multiplier + src2;
-                    int target = target1 * multiplier + target2;
-                    new_transitions.emplace_back(src, target);
-                }
-            }
-
-            // Create a new group if the transitions are not empty
+            TransitionRange transitions2 =
+                ts2.get_transitions(ts2.local_label_infos[bucket.first]);
             LabelGroup &new_labels = bucket.second;
-            if (new_transitions.empty()) {
+            if (transitions1.empty() || transitions2.empty()) {
                 dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
             } else {
-                sort(new_transitions.begin(), new_transitions.end());
-                sort(new_labels.begin(), new_labels.end());
-                int new_local_label = local_label_infos.size();
-                int cost = INF;
-                for (int label : new_labels) {
-                    cost = min(ts1.labels.get_label_cost(label), cost);
-                    label_to_local_label[label] = new_local_label;
-                }
-                local_label_infos.emplace_back(move(new_labels), move(new_transitions), cost);
+                if (transitions1.size() >
+                    (max_num_transitions - num_transitions) / transitions2.size())
+                    utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+                num_transitions += transitions1.size() * transitions2.size();
+                product_label_groups.push_back(
+                    {transitions1, transitions2, move(new_labels)});
             }
         }
     }
 
+    // Now create the new groups together with their transitions.
+    vector<Transition> transitions;
+    transitions.reserve(num_transitions);
+    for (ProductLabelGroup &product_label_group : product_label_groups) {
+        size_t transitions_begin = transitions.size();
+        for (const Transition &transition1 : product_label_group.transitions1) {
+            int src1 = transition1.src;
+            int target1 = transition1.target;
+            for (const Transition &transition2 : product_label_group.transitions2) {
+                int src2 = transition2.src;
+                int target2 = transition2.target;
+                int src = src1 * multiplier + src2;
+                int target = target1 * multiplier + target2;
+                transitions.emplace_back(src, target);
+            }
+        }
+        sort(transitions.begin() + transitions_begin, transitions.end());
+
+        LabelGroup &new_labels = product_label_group.labels;
+        sort(new_labels.begin(), new_labels.end());
+        int new_local_label = local_label_infos.size();
+        int cost = INF;
+        for (int label : new_labels) {
+            cost = min(ts1.labels.get_label_cost(label), cost);
+            label_to_local_label[label] = new_local_label;
+        }
+        local_label_infos.emplace_back(
+            move(new_labels), transitions_begin, transitions.size(), cost);
+    }
+    assert(transitions.size() == num_transitions);
+
     /*
       We collect all dead labels separately, because the bucket refining
       does not work in cases where there are at least two dead labels l1
@@ -279,7 +300,8 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
             label_to_local_label[label] = new_local_label;
         }
         // Dead labels have empty transitions
-        local_label_infos.emplace_back(move(dead_labels), vector<Transition>(), cost);
+        local_label_infos.emplace_back(
+            move(dead_labels), transitions.size(), transitions.size(), cost);
     }
 
     return utils::make_unique_ptr<TransitionSystem>(
@@ -288,6 +310,7 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         ts1.labels,
         move(label_to_local_label),
         move(local_label_infos),
+        move(transitions),
         num_states,
         move(goal_states),
         init_state
@@ -307,11 +330,11 @@ void TransitionSystem::compute_equivalent_local_labels() {
     for (int local_label1 = 0; local_label1 < num_local_labels;
          ++local_label1) {
         if (local_label_infos[local_label1].is_active()) {
-            const vector<Transition> &transitions1 = local_label_infos[local_label1].get_transitions();
+            TransitionRange transitions1 = get_transitions(local_label_infos[local_label1]);
             for (int local_label2 = local_label1 + 1;
                  local_label2 < num_local_labels; ++local_label2) {
                 if (local_label_infos[local_label2].is_active()) {
-                    const vector<Transition> &transitions2 = local_label_infos[local_label2].get_transitions();
+                    TransitionRange transitions2 = get_transitions(local_label_infos[local_label2]);
                     // Comparing transitions directly works because they are sorted and unique.
                     if (transitions1 == transitions2) {
                         for (int label : local_label_infos[local_label2].get_label_group()) {
@@ -325,9 +348,30 @@ void TransitionSystem::compute_equivalent_local_labels() {
         }
     }
 
+    compact_transitions();
     assert(is_valid());
 }
 
+void TransitionSystem::compact_transitions() {
+    size_t num_transitions = 0;
+    for (LocalLabelInfo &local_label_info : local_label_infos) {
+        size_t transitions_begin = num_transitions;
+        if (local_label_info.is_active()) {
+            // Transitions only move to the front, so they are never overwritten.
+            assert(local_label_info.get_transitions_begin() >= num_transitions);
+            if (local_label_info.get_transitions_begin() != num_transitions) {
+                move(transitions.begin() + local_label_info.get_transitions_begin(),
+                     transitions.begin() + local_label_info.get_transitions_end(),
+                     transitions.begin() + num_transitions);
+            }
+            num_transitions += local_label_info.get_transitions_end() -
+                local_label_info.get_transitions_begin();
+        }
+        local_label_info.set_transition_range(transitions_begin, num_transitions);
+    }
+    transitions.erase(transitions.begin() + num_transitions, transitions.end());
+}
+
 void TransitionSystem::apply_abstraction(
     const StateEquivalenceRelation &state_equivalence_relation,
     const vector<int> &abstraction_mapping,
@@ -356,31 +400,28 @@ void TransitionSystem::apply_abstraction(
     }
     goal_states = move(new_goal_states);
 
-    // Update all transitions.
+    /*
+      Update all transitions in place. Since the transitions are stored in
+      the order of the local labels, the updated transitions of a local
+      label never overwrite transitions that have not been updated yet.
+    */
+    size_t num_transitions = 0;
     for (LocalLabelInfo &local_label_info : local_label_infos) {
-        const vector<Transition> &transitions = local_label_info.get_transitions();
-        if (!transitions.empty()) {
-            vector<Transition> new_transitions;
-            /*
-            We reserve more memory than necessary here, but this is better
-            than potentially resizing the vector several times when inserting
-            transitions one after the other. See issue604-v6.
-
-            An alternative could be to not use a new vector, but to modify
-            the existing transitions inplace, and to remove all empty
-            positions in the end. This would be more ugly, though.
-            */
-            new_transitions.reserve(transitions.size());
-            for (const Transition &transition : transitions) {
-                int src = abstraction_mapping[transition.src];
-                int target = abstraction_mapping[transition.target];
-                if (src != PRUNED_STATE && target != PRUNED_STATE)
-                    new_transitions.emplace_back(src, target);
-            }
-            utils::sort_unique(new_transitions);
-            local_label_info.replace_transitions(move(new_transitions));
+        size_t transitions_begin = num_transitions;
+        for (size_t i = local_label_info.get_transitions_begin();
+             i < local_label_info.get_transitions_end(); ++i) {
+            int src = abstraction_mapping[transitions[i].src];
+            int target = abstraction_mapping[transitions[i].target];
+            if (src != PRUNED_STATE && target != PRUNED_STATE)
+                transitions[num_transitions++] = Transition(src, target);
         }
+        auto first = transitions.begin() + transitions_begin;
+        auto last = transitions.begin() + num_transitions;
+        sort(first, last);
+        num_transitions = unique(first, last) - transitions.begin();
+        local_label_info.set_transition_range(transitions_begin, num_transitions);
     }
+    transitions.erase(transitions.begin() + num_transitions, transitions.end());
 
     compute_equivalent_local_labels();
 
@@ -443,6 +484,9 @@ void TransitionSystem::apply_label_reduction(
           as a new local label and update the label_to_local_label mapping.
         */
         unordered_map<int, vector<int>> local_label_to_old_labels;
+        int num_old_local_labels = local_label_infos.size();
+        vector<vector<Transition>> new_local_label_transitions;
+        new_local_label_transitions.reserve(label_mapping.size());
         for (const pair<int, vector<int>> &mapping: label_mapping) {
             const vector<int> &old_labels = mapping.second;
             assert(old_labels.size() >= 2);
@@ -451,22 +495,29 @@ void TransitionSystem::apply_label_reduction(
             for (int old_label : old_labels) {
                 int old_local_label = label_to_local_label[old_label];
                 if (seen_local_labels.insert(old_local_label).second) {
-                    const vector<Transition> &transitions = local_label_infos[old_local_label].get_transitions();
-                    new_label_transitions.insert(new_label_transitions.end(), transitions.begin(), transitions.end());
+                    TransitionRange old_transitions =
+                        get_transitions(local_label_infos[old_local_label]);
+                    new_label_transitions.insert(
+                        new_label_transitions.end(),
+                        old_transitions.begin(), old_transitions.end());
                 }
                 local_label_to_old_labels[old_local_label].push_back(old_label);
                 // Reset (for consistency only, old labels are never accessed).
                 label_to_local_label[old_label] = -1;
             }
             utils::sort_unique(new_label_transitions);
+            new_local_label_transitions.push_back(move(new_label_transitions));
 
             int new_label = mapping.first;
             int new_local_label = local_label_infos.size();
             label_to_local_label[new_label] = new_local_label;
             int new_cost = labels.get_label_cost(new_label);
 
+            // The transitions are added below.
             LabelGroup new_label_group = {new_label};
-            local_label_infos.emplace_back(move(new_label_group), move(new_label_transitions), new_cost);
+            local_label_infos.emplace_back(
+                move(new_label_group), transitions.size(), transitions.size(),
+                new_cost);
         }
 
         /*
@@ -479,6 +530,27 @@ void TransitionSystem::apply_label_reduction(
             local_label_infos[entry.first].recompute_cost(labels);
         }
 
+        /*
+          Drop the transitions of local labels without labels before adding
+          the transitions of the new local labels, so that the transition
+          array grows as little as possible.
+        */
+        compact_transitions();
+        size_t num_new_transitions = 0;
+        for (const vector<Transition> &new_transitions : new_local_label_transitions) {
+            num_new_transitions += new_transitions.size();
+        }
+        transitions.reserve(transitions.size() + num_new_transitions);
+        for (size_t i = 0; i < new_local_label_transitions.size(); ++i) {
+            vector<Transition> &new_transitions = new_local_label_transitions[i];
+            size_t transitions_begin = transitions.size();
+            transitions.insert(
+                transitions.end(), new_transitions.begin(), new_transitions.end());
+            utils::release_vector_memory(new_transitions);
+            local_label_infos[num_old_local_labels + i].set_transition_range(
+                transitions_begin, transitions.size());
+        }
+
         compute_equivalent_local_labels();
     }
 
@@ -492,9 +564,18 @@ string TransitionSystem::tag() const {
 }
 
 bool TransitionSystem::are_local_labels_consistent() const {
+    size_t previous_transitions_end = 0;
     for (const LocalLabelInfo &local_label_info : *this) {
-        if (!local_label_info.is_consistent())
+        if (!local_label_info.is_consistent() ||
+            local_label_info.get_transitions_begin() < previous_transitions_end ||
+            local_label_info.get_transitions_end() > transitions.size())
+            return false;
+        TransitionRange local_transitions = get_transitions(local_label_info);
+        if (!is_sorted(local_transitions.begin(), local_transitions.end()) ||
+            adjacent_find(local_transitions.begin(), local_transitions.end())
+            != local_transitions.end())
             return false;
+        previous_transitions_end = local_label_info.get_transitions_end();
     }
     return true;
 }
@@ -564,7 +645,7 @@ bool TransitionSystem::is_solvable(const Distances &distances) const {
 int TransitionSystem::compute_total_transitions() const {
     int total = 0;
     for (const LocalLabelInfo &local_label_info : *this) {
-        total += local_label_info.get_transitions().size();
+        total += get_transitions(local_label_info).size();
     }
     return total;
 }
@@ -598,8 +679,7 @@ void TransitionSystem::dump_dot_graph(utils::LogProxy &log) const {
         }
         for (const LocalLabelInfo &local_label_info : *this) {
             const LabelGroup &label_group = local_label_info.get_label_group();
-            const vector<Transition> &transitions = local_label_info.get_transitions();
-            for (const Transition &transition : transitions) {
+            for (const Transition &transition : get_transitions(local_label_info)) {
                 int src = transition.src;
                 int target = transition.target;
                 log << "    node" << src << " -> node" << target << " [label = ";
@@ -622,10 +702,10 @@ void TransitionSystem::dump_labels_and_transitions(utils::LogProxy &log) const {
             const LabelGroup &label_group = local_label_info.get_label_group();
             log << "labels: " << label_group << endl;
             log << "transitions: ";
-            const vector<Transition> &transitions = local_label_info.get_transitions();
-            for (size_t i = 0; i < transitions.size(); ++i) {
-                int src = transitions[i].src;
-                int target = transitions[i].target;
+            TransitionRange local_transitions = get_transitions(local_label_info);
+            for (size_t i = 0; i < local_transitions.size(); ++i) {
+                int src = local_transitions[i].src;
+                int target = local_transitions[i].target;
                 if (i != 0)
                     log << ",";
                 log << src << " -> " << target;
@@ -5,6 +5,7 @@
 
 #include "../utils/collections.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -43,26 +44,72 @@ struct Transition {
 
 using LabelGroup = std::vector<int>;
 
+/*
+  View of the transitions of a local label, which are stored consecutively
+  in the transition array of their transition system. The view is
+  invalidated by all operations that modify the transition system.
+*/
+class TransitionRange {
+    const Transition *first;
+    const Transition *last;
+public:
+    TransitionRange(const Transition *first, const Transition *last)
+        : first(first), last(last) {
+    }
+
+    const Transition *begin() const {
+        return first;
+    }
+
+    const Transition *end() const {
+        return last;
+    }
+
+    std::size_t size() const {
+        return last - first;
+    }
+
+    bool empty() const {
+        return first == last;
+    }
+
+    const Transition &operator[](std::size_t index) const {
+        return first[index];
+    }
+
+    bool operator==(const TransitionRange &other) const {
+        return size() == other.size() &&
+               std::equal(first, last, other.first);
+    }
+};
+
 /*
   Class for representing groups of labels with equivalent transitions in a
   transition system. See also documentation for TransitionSystem.
 
-  The local label is in a consistent state if label_group and transitions
-  are sorted and unique.
+  The transitions themselves are stored by the transition system, the local
+  label only knows their position [transitions_begin, transitions_end) in
+  the transition array of the transition system.
+
+  The local label is in a consistent state if label_group is sorted and
+  unique.
 */
 class LocalLabelInfo {
     // The sorted set of labels with identical transitions in a transition system.
     LabelGroup label_group;
-    std::vector<Transition> transitions;
+    std::size_t transitions_begin;
+    std::size_t transitions_end;
     // The cost is the minimum cost over all labels in label_group.
     int cost;
 public:
     LocalLabelInfo(
         LabelGroup &&label_group,
-        std::vector<Transition> &&transitions,
+        std::size_t transitions_begin,
+        std::size_t transitions_end,
         int cost)
         : label_group(move(label_group)),
-          transitions(move(transitions)),
+          transitions_begin(transitions_begin),
+          transitions_end(transitions_end),
           cost(cost) {
         assert(is_consistent());
     }
@@ -80,7 +127,13 @@ public:
     void remove_labels(const std::vector<int> &old_labels);
 
     void recompute_cost(const Labels &labels);
-    void replace_transitions(std::vector<Transition> &&new_transitions);
+
+    // Only to be used by the transition system after moving the transitions.
+    void set_transition_range(
+        std::size_t new_transitions_begin, std::size_t new_transitions_end) {
+        transitions_begin = new_transitions_begin;
+        transitions_end = new_transitions_end;
+    }
 
     /*
       The given local label must have identical transitions. Its labels are
@@ -101,8 +154,12 @@ public:
         return label_group;
     }
 
-    const std::vector<Transition> &get_transitions() const {
-        return transitions;
+    std::size_t get_transitions_begin() const {
+        return transitions_begin;
+    }
+
+    std::size_t get_transitions_end() const {
+        return transitions_end;
     }
 
     int get_cost() const {
@@ -166,6 +223,13 @@ private:
     */
     std::vector<int> label_to_local_label;
     std::vector<LocalLabelInfo> local_label_infos;
+    /*
+      The transitions of all local labels in one array (compressed sparse
+      row format). The transitions of active local labels are stored in the
+      order of the local labels without gaps, inactive local labels have no
+      transitions.
+    */
+    std::vector<Transition> transitions;
 
     int num_states;
     std::vector<bool> goal_states;
@@ -177,13 +241,21 @@ private:
     */
     void compute_equivalent_local_labels();
 
+    /*
+      Move the transitions of all active local labels to the front of the
+      transition array, dropping the transitions of inactive local labels.
+    */
+    void compact_transitions();
+
     // Statistics and output
     int compute_total_transitions() const;
     std::string get_description() const;
 
     /*
       The transitions for every group of locally equivalent labels are
-      sorted (by source, by target) and there are no duplicates.
+      sorted (by source, by target) and there are no duplicates. The
+      transitions of the local labels are stored in the order of the local
+      labels.
     */
     bool are_local_labels_consistent() const;
 
@@ -199,6 +271,7 @@ public:
         const Labels &labels,
         std::vector<int> &&label_to_local_label,
         std::vector<LocalLabelInfo> &&local_label_infos,
+        std::vector<Transition> &&transitions,
         int num_states,
         std::vector<bool> &&goal_states,
         int init_state);
@@ -253,6 +326,12 @@ public:
     */
     std::string tag() const;
 
+    TransitionRange get_transitions(const LocalLabelInfo &local_label_info) const {
+        return TransitionRange(
+            transitions.data() + local_label_info.get_transitions_begin(),
+            transitions.data() + local_label_info.get_transitions_end());
+    }
+
     bool is_valid() const;
 
     bool is_solvable(const Distances &distances) const;
@@ -90,6 +90,12 @@ public:
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) = 0;
 
+    /*
+      Add all heuristics that this open list uses (directly or indirectly)
+      into the result set.
+    */
+    virtual void get_heuristics(std::set<Evaluator *> &evals) = 0;
+
     /*
       Accessor method for only_preferred.
 
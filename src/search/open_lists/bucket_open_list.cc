@@ -0,0 +1,278 @@
+#include "bucket_open_list.h"
+
+#include "../evaluation_result.h"
+#include "../evaluator.h"
+#include "../open_list.h"
+
+#include "../plugins/plugin.h"
+#include "../utils/memory.h"
+
+#include <cassert>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+namespace bucket_open_list {
+template<class Entry>
+class Bucket {
+    vector<Entry> entries;
+    // Entries before this index have already been removed (FIFO order).
+    size_t first;
+public:
+    Bucket() : first(0) {
+    }
+
+    bool empty() const {
+        return first == entries.size();
+    }
+
+    void push(const Entry &entry) {
+        entries.push_back(entry);
+    }
+
+    Entry pop(bool lifo) {
+        assert(!empty());
+        Entry result = lifo ? entries.back() : entries[first];
+        if (lifo)
+            entries.pop_back();
+        else
+            ++first;
+        if (empty()) {
+            // Keep the memory: the bucket is likely to be filled again soon.
+            entries.clear();
+            first = 0;
+        }
+        return result;
+    }
+};
+
+/*
+  Elements of type T indexed by non-negative keys, plus one element for
+  the key infinity. Only the range between the smallest and the largest
+  finite key used since the array was last empty is stored.
+*/
+template<class T>
+struct KeyedArray {
+    vector<T> elements;
+    T infinite_element;
+    int offset;
+    // There is no non-empty element with a finite key below min_key.
+    int min_key;
+    // Number of entries stored in all elements together.
+    int size;
+
+    KeyedArray()
+        : offset(0), min_key(numeric_limits<int>::max()), size(0) {
+    }
+
+    bool empty() const {
+        return size == 0;
+    }
+
+    T &get(int key) {
+        if (key == EvaluationResult::INFTY)
+            return infinite_element;
+        assert(key >= 0);
+        if (elements.empty()) {
+            offset = key;
+        } else if (key < offset) {
+            elements.insert(elements.begin(), offset - key, T());
+            offset = key;
+        }
+        int index = key - offset;
+        if (index >= static_cast<int>(elements.size()))
+            elements.resize(index + 1);
+        min_key = min(min_key, key);
+        return elements[index];
+    }
+
+    T &get_min() {
+        assert(!empty());
+        int num_elements = elements.size();
+        int index = max(min_key, offset) - offset;
+        while (index < num_elements && elements[index].empty())
+            ++index;
+        min_key = offset + index;
+        if (index == num_elements)
+            return infinite_element;
+        return elements[index];
+    }
+};
+
+template<class Entry>
+class BucketOpenList : public OpenList<Entry> {
+    // Buckets with the same first key, indexed by the second key.
+    using Level = KeyedArray<Bucket<Entry>>;
+
+    KeyedArray<Level> levels;
+
+    vector<shared_ptr<Evaluator>> evaluators;
+    bool lifo;
+    /*
+      If allow_unsafe_pruning is true, we ignore (don't insert) states
+      which the first evaluator considers a dead end, even if it is
+      not a safe heuristic.
+    */
+    bool allow_unsafe_pruning;
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit BucketOpenList(const plugins::Options &opts);
+    virtual ~BucketOpenList() override = default;
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_heuristics(set<Evaluator *> &evals) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+
+template<class Entry>
+BucketOpenList<Entry>::BucketOpenList(const plugins::Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      evaluators(opts.get_list<shared_ptr<Evaluator>>("evals")),
+      lifo(opts.get<bool>("lifo")),
+      allow_unsafe_pruning(opts.get<bool>("unsafe_pruning")) {
+    assert(evaluators.size() == 1 || evaluators.size() == 2);
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    int first_key = eval_context.get_evaluator_value_or_infinity(
+        evaluators[0].get());
+    int second_key = 0;
+    if (evaluators.size() == 2) {
+        second_key = eval_context.get_evaluator_value_or_infinity(
+            evaluators[1].get());
+    }
+    Level &level = levels.get(first_key);
+    level.get(second_key).push(entry);
+    ++level.size;
+    ++levels.size;
+}
+
+template<class Entry>
+Entry BucketOpenList<Entry>::remove_min() {
+    Level &level = levels.get_min();
+    Entry result = level.get_min().pop(lifo);
+    --levels.size;
+    if (--level.size == 0) {
+        // Levels below the minimum f value of A* are never used again.
+        level = Level();
+    }
+    return result;
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::empty() const {
+    return levels.empty();
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::clear() {
+    levels = KeyedArray<Level>();
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_path_dependent_evaluators(evals);
+}
+
+template<class Entry>
+void BucketOpenList<Entry>::get_heuristics(
+    set<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_heuristics(evals);
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    // Same semantics as for the tie-breaking open list.
+    if (is_reliable_dead_end(eval_context))
+        return true;
+    if (allow_unsafe_pruning &&
+        eval_context.is_evaluator_value_infinite(evaluators[0].get()))
+        return true;
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        if (!eval_context.is_evaluator_value_infinite(evaluator.get()))
+            return false;
+    return true;
+}
+
+template<class Entry>
+bool BucketOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+BucketOpenListFactory::BucketOpenListFactory(const plugins::Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+BucketOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+BucketOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<BucketOpenList<EdgeOpenListEntry>>(options);
+}
+
+class BucketOpenListFeature : public plugins::TypedFeature<OpenListFactory, BucketOpenListFactory> {
+public:
+    BucketOpenListFeature() : TypedFeature("buckets") {
+        document_title("Bucket-based tie-breaking open list");
+        document_synopsis(
+            "Orders entries lexicographically by the values of one or two "
+            "evaluators, like the tie-breaking open list, but stores them in "
+            "arrays of buckets indexed by these values. Inserting and "
+            "removing entries does not need any comparisons of keys. Memory "
+            "usage grows with the range of values that occur, so this open "
+            "list is intended for evaluators with small values such as g+h "
+            "and h in A* on tasks with small operator costs.");
+
+        add_list_option<shared_ptr<Evaluator>>("evals", "one or two evaluators");
+        add_option<bool>(
+            "pref_only",
+            "insert only nodes generated by preferred operators", "false");
+        add_option<bool>(
+            "lifo",
+            "remove entries with equal values in last-in-first-out order "
+            "(the default is first-in-first-out order as in the tie-breaking "
+            "open list)",
+            "false");
+        add_option<bool>(
+            "unsafe_pruning",
+            "allow unsafe pruning when the main evaluator regards a state a dead end",
+            "true");
+    }
+
+    virtual shared_ptr<BucketOpenListFactory> create_component(const plugins::Options &options, const utils::Context &context) const override {
+        plugins::verify_list_non_empty<shared_ptr<Evaluator>>(context, options, "evals");
+        if (options.get_list<shared_ptr<Evaluator>>("evals").size() > 2) {
+            context.error("The bucket open list supports at most two evaluators.");
+        }
+        return make_shared<BucketOpenListFactory>(options);
+    }
+};
+
+static plugins::FeaturePlugin<BucketOpenListFeature> _plugin;
+}
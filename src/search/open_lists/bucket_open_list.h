@@ -0,0 +1,33 @@
+#ifndef OPEN_LISTS_BUCKET_OPEN_LIST_H
+#define OPEN_LISTS_BUCKET_OPEN_LIST_H
+
+#include "../open_list_factory.h"
+
+#include "../plugins/plugin.h"
+
+/*
+  Open list for one or two evaluators that orders entries
+  lexicographically by their values, like a tie-breaking open list.
+
+  Instead of a map with vector keys, the entries are stored in a
+  two-level array of buckets that is indexed by the value of the first
+  and the second evaluator. Inserting and removing an entry therefore
+  takes constant time plus the time for skipping empty buckets, which
+  is small if the values of the entries do not jump far (e.g., f and h
+  values in A*). The arrays only cover the range of values that occur,
+  so memory usage grows with the difference between the smallest and
+  largest finite value rather than with the values themselves.
+*/
+namespace bucket_open_list {
+class BucketOpenListFactory : public OpenListFactory {
+    plugins::Options options;
+public:
+    explicit BucketOpenListFactory(const plugins::Options &options);
+    virtual ~BucketOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+}
+
+#endif
@@ -43,6 +43,7 @@ public:
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_heuristics(set<Evaluator *> &evals) override;
 };
 
 template<class Entry>
@@ -134,6 +135,14 @@ void TypeBasedOpenList<Entry>::get_path_dependent_evaluators(
     }
 }
 
+template<class Entry>
+void TypeBasedOpenList<Entry>::get_heuristics(
+    set<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators) {
+        evaluator->get_heuristics(evals);
+    }
+}
+
 TypeBasedOpenListFactory::TypeBasedOpenListFactory(
     const plugins::Options &options)
     : options(options) {
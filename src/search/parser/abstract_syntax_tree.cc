@@ -16,13 +16,24 @@
 using namespace std;
 
 namespace parser {
+/*
+  Constructing the registry registers the types of all plugins, which
+  may only happen once. We construct it on first use, so that several
+  configurations can be decorated in one run.
+*/
+static const plugins::Registry &get_plugin_registry() {
+    static const plugins::Registry registry =
+        plugins::RawRegistry::instance()->construct_registry();
+    return registry;
+}
+
 class DecorateContext : public utils::Context {
-    const plugins::Registry registry;
+    const plugins::Registry &registry;
     unordered_map<string, const plugins::Type *> variables;
 
 public:
     DecorateContext()
-        : registry(plugins::RawRegistry::instance()->construct_registry()) {
+        : registry(get_plugin_registry()) {
     }
 
     void add_variable(const string &name, const plugins::Type &type) {
@@ -6,6 +6,7 @@
 #include <cassert>
 #include <iostream>
 #include <limits>
+#include <numeric>
 
 using namespace std;
 
@@ -13,31 +14,123 @@ namespace pdbs {
 CanonicalPDBs::CanonicalPDBs(
     const shared_ptr<PDBCollection> &pdbs,
     const shared_ptr<vector<PatternClique>> &pattern_cliques)
-    : pdbs(pdbs), pattern_cliques(pattern_cliques) {
+    : pdbs(pdbs), pattern_cliques(pattern_cliques), max_pattern_size(0) {
     assert(pdbs);
     assert(pattern_cliques);
+
+    vector<int> order(pdbs->size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int i, int j) {
+             return (*pdbs)[i]->get_pattern() < (*pdbs)[j]->get_pattern();
+         });
+
+    const Pattern *previous_pattern = nullptr;
+    for (int pdb_index : order) {
+        const PatternDatabase &pdb = *(*pdbs)[pdb_index];
+        const Pattern &pattern = pdb.get_pattern();
+        int pattern_size = pattern.size();
+        max_pattern_size = max(max_pattern_size, pattern_size);
+        int prefix_length = 0;
+        if (previous_pattern) {
+            auto mismatch_pos = mismatch(
+                pattern.begin(), pattern.end(),
+                previous_pattern->begin(), previous_pattern->end());
+            prefix_length = mismatch_pos.first - pattern.begin();
+        }
+        int first_term = rank_vars.size();
+        for (int i = prefix_length; i < pattern_size; ++i) {
+            rank_vars.push_back(pattern[i]);
+            rank_multipliers.push_back(pdb.get_projection().get_multiplier(i));
+        }
+        ranked_pdbs.push_back(
+            {&pdb, pdb_index, prefix_length, first_term,
+             static_cast<int>(rank_vars.size())});
+        previous_pattern = &pattern;
+    }
+
+    for (const PatternClique &clique : *pattern_cliques) {
+        clique_pdbs.insert(clique_pdbs.end(), clique.begin(), clique.end());
+        clique_ends.push_back(clique_pdbs.size());
+    }
+
+    partial_ranks.resize(max_pattern_size + 1, 0);
+    ranks.resize(ranked_pdbs.size());
+    h_values.resize(ranked_pdbs.size());
 }
 
-int CanonicalPDBs::get_value(const State &state) const {
+int CanonicalPDBs::get_value(const State &state) {
     // If we have an empty collection, then pattern_cliques = { \emptyset }.
-    assert(!pattern_cliques->empty());
-    int max_h = 0;
-    vector<int> h_values;
-    h_values.reserve(pdbs->size());
+    assert(!clique_ends.empty());
     state.unpack();
-    for (const shared_ptr<PatternDatabase> &pdb : *pdbs) {
-        int h = pdb->get_value(state.get_unpacked_values());
+    const vector<int> &values = state.get_unpacked_values();
+
+    // partial_ranks[0] is always 0, the other entries are set before use.
+    for (const RankedPDB &ranked_pdb : ranked_pdbs) {
+        int length = ranked_pdb.prefix_length;
+        int rank = partial_ranks[length];
+        for (int term = ranked_pdb.first_term; term < ranked_pdb.end_term;
+             ++term) {
+            rank += rank_multipliers[term] * values[rank_vars[term]];
+            partial_ranks[++length] = rank;
+        }
+        int h = ranked_pdb.pdb->get_distance(rank);
         if (h == numeric_limits<int>::max()) {
             return numeric_limits<int>::max();
         }
-        h_values.push_back(h);
+        h_values[ranked_pdb.pdb_index] = h;
     }
-    for (const PatternClique &clique : *pattern_cliques) {
+
+    int max_h = 0;
+    int clique_begin = 0;
+    for (int clique_end : clique_ends) {
         int clique_h = 0;
-        for (PatternID pdb_index : clique) {
-            clique_h += h_values[pdb_index];
+        for (int i = clique_begin; i < clique_end; ++i) {
+            clique_h += h_values[clique_pdbs[i]];
         }
         max_h = max(max_h, clique_h);
+        clique_begin = clique_end;
+    }
+    return max_h;
+}
+
+int CanonicalPDBs::get_value(const State &state, int upper_bound) {
+    assert(!clique_ends.empty());
+    state.unpack();
+    const vector<int> &values = state.get_unpacked_values();
+
+    for (const RankedPDB &ranked_pdb : ranked_pdbs) {
+        int length = ranked_pdb.prefix_length;
+        int rank = partial_ranks[length];
+        for (int term = ranked_pdb.first_term; term < ranked_pdb.end_term;
+             ++term) {
+            rank += rank_multipliers[term] * values[rank_vars[term]];
+            partial_ranks[++length] = rank;
+        }
+        ranks[ranked_pdb.pdb_index] = rank;
+    }
+
+    // h_values[i] is -1 until PDB i has been looked up.
+    fill(h_values.begin(), h_values.end(), -1);
+    int max_h = 0;
+    int clique_begin = 0;
+    for (int clique_end : clique_ends) {
+        int clique_h = 0;
+        for (int i = clique_begin; i < clique_end; ++i) {
+            int pdb_index = clique_pdbs[i];
+            int &h = h_values[pdb_index];
+            if (h == -1) {
+                h = (*pdbs)[pdb_index]->get_distance(ranks[pdb_index]);
+                if (h == numeric_limits<int>::max()) {
+                    return numeric_limits<int>::max();
+                }
+            }
+            clique_h += h;
+        }
+        max_h = max(max_h, clique_h);
+        if (max_h > upper_bound) {
+            return max_h;
+        }
+        clique_begin = clique_end;
     }
     return max_h;
 }
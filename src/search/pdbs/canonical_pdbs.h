@@ -4,21 +4,82 @@
 #include "types.h"
 
 #include <memory>
+#include <vector>
 
 class State;
 
 namespace pdbs {
+/*
+  Evaluating the canonical heuristic is the hot path of the search, so we
+  compile the PDBs and the pattern cliques into flat arrays.
+
+  The PDBs are evaluated in lexicographic order of their patterns. The
+  hash multiplier of a variable only depends on the variables that come
+  before it in the pattern, so patterns with a common prefix have the same
+  partial rank for this prefix. We therefore only compute the partial rank
+  of the part of each pattern that it does not share with the previously
+  evaluated pattern. The pattern cliques are stored as one array of PDB
+  indices.
+
+  Given an upper bound, we compute the ranks for all PDBs, but only look
+  up the PDBs when a clique needs them, so that evaluation can stop as
+  soon as one clique exceeds the bound. Without a bound, we look up each
+  PDB right after computing its rank, which is faster.
+
+  The object keeps the given PDBs and cliques alive but does not notice
+  later changes to them.
+*/
 class CanonicalPDBs {
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
 
+    struct RankedPDB {
+        const PatternDatabase *pdb;
+        // Index of the PDB in pdbs and in the cliques.
+        int pdb_index;
+        // Length of the prefix shared with the previously evaluated pattern.
+        int prefix_length;
+        // The remaining variables are in rank_vars[first_term, end_term).
+        int first_term;
+        int end_term;
+    };
+
+    std::vector<RankedPDB> ranked_pdbs;
+    // Variables and hash multipliers of the rank computations.
+    std::vector<int> rank_vars;
+    std::vector<int> rank_multipliers;
+    int max_pattern_size;
+
+    /*
+      The PDB indices of all cliques, one clique after the other. Clique i
+      ends before clique_pdbs[clique_ends[i]].
+    */
+    std::vector<int> clique_pdbs;
+    std::vector<int> clique_ends;
+
+    /*
+      Buffers reused by get_value. partial_ranks[i] is the partial rank of
+      the first i variables of the pattern evaluated last, ranks and
+      h_values are indexed by PDB index.
+    */
+    std::vector<int> partial_ranks;
+    std::vector<int> ranks;
+    std::vector<int> h_values;
+
 public:
     CanonicalPDBs(
         const std::shared_ptr<PDBCollection> &pdbs,
         const std::shared_ptr<std::vector<PatternClique>> &pattern_cliques);
     ~CanonicalPDBs() = default;
 
-    int get_value(const State &state) const;
+    // Not const because the evaluation reuses the buffers of the object.
+    int get_value(const State &state);
+
+    /*
+      Like get_value, but if the value exceeds upper_bound, the result may
+      be any value above upper_bound.
+    */
+    int get_value(const State &state, int upper_bound);
 };
 }
 
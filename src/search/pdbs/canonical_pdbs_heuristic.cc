@@ -67,6 +67,10 @@ CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(const plugins::Options &opts)
       canonical_pdbs(get_canonical_pdbs_from_options(task, opts, log)) {
 }
 
+shared_ptr<Evaluator> CanonicalPDBsHeuristic::create_thread_copy() const {
+    return make_shared<CanonicalPDBsHeuristic>(*this);
+}
+
 int CanonicalPDBsHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     int h = canonical_pdbs.get_value(state);
@@ -77,6 +81,17 @@ int CanonicalPDBsHeuristic::compute_heuristic(const State &ancestor_state) {
     }
 }
 
+int CanonicalPDBsHeuristic::compute_bounded_heuristic(
+    const State &ancestor_state, int upper_bound) {
+    State state = convert_ancestor_state(ancestor_state);
+    int h = canonical_pdbs.get_value(state, upper_bound);
+    if (h == numeric_limits<int>::max()) {
+        return DEAD_END;
+    } else {
+        return h;
+    }
+}
+
 void add_canonical_pdbs_options_to_feature(plugins::Feature &feature) {
     feature.add_option<double>(
         "max_time_dominance_pruning",
@@ -16,10 +16,14 @@ class CanonicalPDBsHeuristic : public Heuristic {
 
 protected:
     virtual int compute_heuristic(const State &ancestor_state) override;
+    virtual int compute_bounded_heuristic(
+        const State &ancestor_state, int upper_bound) override;
 
 public:
     explicit CanonicalPDBsHeuristic(const plugins::Options &opts);
     virtual ~CanonicalPDBsHeuristic() = default;
+
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const override;
 };
 
 void add_canonical_pdbs_options_to_feature(plugins::Feature &feature);
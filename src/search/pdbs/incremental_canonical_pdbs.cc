@@ -1,9 +1,10 @@
 #include "incremental_canonical_pdbs.h"
 
-#include "canonical_pdbs.h"
 #include "pattern_database.h"
 #include "pattern_database_factory.h"
 
+#include "../utils/memory.h"
+
 #include <limits>
 
 using namespace std;
@@ -39,6 +40,8 @@ void IncrementalCanonicalPDBs::add_pdb(const shared_ptr<PatternDatabase> &pdb) {
 void IncrementalCanonicalPDBs::recompute_pattern_cliques() {
     pattern_cliques = compute_pattern_cliques(*patterns,
                                               are_additive);
+    canonical_pdbs = utils::make_unique_ptr<CanonicalPDBs>(
+        pattern_databases, pattern_cliques);
 }
 
 vector<PatternClique> IncrementalCanonicalPDBs::get_pattern_cliques(
@@ -48,8 +51,53 @@ vector<PatternClique> IncrementalCanonicalPDBs::get_pattern_cliques(
 }
 
 int IncrementalCanonicalPDBs::get_value(const State &state) const {
-    CanonicalPDBs canonical_pdbs(pattern_databases, pattern_cliques);
-    return canonical_pdbs.get_value(state);
+    return canonical_pdbs->get_value(state);
+}
+
+vector<int> IncrementalCanonicalPDBs::get_pdb_values(
+    const State &state) const {
+    state.unpack();
+    vector<int> h_values;
+    h_values.reserve(pattern_databases->size());
+    for (const shared_ptr<PatternDatabase> &pdb : *pattern_databases)
+        h_values.push_back(pdb->get_value(state.get_unpacked_values()));
+    return h_values;
+}
+
+vector<int> IncrementalCanonicalPDBs::get_clique_values(
+    const vector<int> &pdb_values) const {
+    vector<int> clique_values;
+    clique_values.reserve(pattern_cliques->size());
+    for (const PatternClique &clique : *pattern_cliques) {
+        int clique_h = 0;
+        for (PatternID pattern_id : clique) {
+            clique_h += pdb_values[pattern_id];
+        }
+        clique_values.push_back(clique_h);
+    }
+    return clique_values;
+}
+
+vector<PatternClique> IncrementalCanonicalPDBs::get_non_additive_patterns(
+    const Pattern &new_pattern) const {
+    vector<bool> is_additive;
+    is_additive.reserve(patterns->size());
+    for (const Pattern &pattern : *patterns) {
+        is_additive.push_back(
+            are_patterns_additive(new_pattern, pattern, are_additive));
+    }
+    vector<PatternClique> non_additive_patterns;
+    non_additive_patterns.reserve(pattern_cliques->size());
+    for (const PatternClique &clique : *pattern_cliques) {
+        PatternClique removed_patterns;
+        for (PatternID pattern_id : clique) {
+            if (!is_additive[pattern_id]) {
+                removed_patterns.push_back(pattern_id);
+            }
+        }
+        non_additive_patterns.push_back(move(removed_patterns));
+    }
+    return non_additive_patterns;
 }
 
 bool IncrementalCanonicalPDBs::is_dead_end(const State &state) const {
@@ -1,6 +1,7 @@
 #ifndef PDBS_INCREMENTAL_CANONICAL_PDBS_H
 #define PDBS_INCREMENTAL_CANONICAL_PDBS_H
 
+#include "canonical_pdbs.h"
 #include "pattern_cliques.h"
 #include "pattern_collection_information.h"
 #include "types.h"
@@ -16,6 +17,8 @@ class IncrementalCanonicalPDBs {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pattern_databases;
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
+    // Compiled from pattern_databases and pattern_cliques.
+    std::unique_ptr<CanonicalPDBs> canonical_pdbs;
 
     // A pair of variables is additive if no operator has an effect on both.
     VariableAdditivity are_additive;
@@ -41,6 +44,30 @@ public:
 
     int get_value(const State &state) const;
 
+    /*
+      Returns the h-values of all PDBs in the collection for the given state
+      in the order of get_pattern_databases().
+    */
+    std::vector<int> get_pdb_values(const State &state) const;
+
+    /*
+      Returns the sum of the given PDB h-values (see get_pdb_values) for
+      each pattern clique of the collection. The canonical heuristic value
+      is the maximum of these sums.
+    */
+    std::vector<int> get_clique_values(const std::vector<int> &pdb_values) const;
+
+    /*
+      Returns the patterns of each pattern clique of the collection that are
+      not additive with new_pattern. Removing them from the cliques yields
+      the cliques of get_pattern_cliques(new_pattern), except that empty
+      cliques and duplicates are included. This lets us compute the h-values
+      of these cliques from the result of get_clique_values() by only
+      subtracting the h-values of the few removed patterns.
+    */
+    std::vector<PatternClique> get_non_additive_patterns(
+        const Pattern &new_pattern) const;
+
     /*
       The following method offers a quick dead-end check for the sampling
       procedure of iPDB-hillclimbing. This exists because we can much more
@@ -43,7 +43,7 @@ PatternCollectionInformation PatternCollectionGeneratorCombo::compute_patterns(
         }
     }
 
-    PatternCollectionInformation pci(task_proxy, patterns, log);
+    PatternCollectionInformation pci(task_proxy, patterns, log, num_threads);
     return pci;
 }
 
@@ -55,7 +55,7 @@ public:
             "maximum abstraction size for combo strategy",
             "1000000",
             plugins::Bounds("1", "infinity"));
-        add_generator_options_to_feature(*this);
+        add_collection_generator_options_to_feature(*this);
     }
 };
 
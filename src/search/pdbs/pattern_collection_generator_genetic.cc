@@ -294,7 +294,8 @@ PatternCollectionInformation PatternCollectionGeneratorGenetic::compute_patterns
 
     TaskProxy task_proxy(*task);
     assert(best_patterns);
-    return PatternCollectionInformation(task_proxy, best_patterns, log);
+    return PatternCollectionInformation(
+        task_proxy, best_patterns, log, num_threads);
 }
 
 class PatternCollectionGeneratorGeneticFeature : public plugins::TypedFeature<PatternCollectionGenerator, PatternCollectionGeneratorGenetic> {
@@ -345,7 +346,7 @@ public:
             "fitness) if its patterns are not disjoint",
             "false");
         utils::add_rng_options(*this);
-        add_generator_options_to_feature(*this);
+        add_collection_generator_options_to_feature(*this);
 
         document_note(
             "Note",
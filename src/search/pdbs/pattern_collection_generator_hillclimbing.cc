@@ -17,11 +17,13 @@
 #include "../utils/markup.h"
 #include "../utils/math.h"
 #include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <limits>
@@ -132,7 +134,7 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
     PDBCollection &candidate_pdbs) {
     const Pattern &pattern = pdb.get_pattern();
     int pdb_size = pdb.get_size();
-    int max_pdb_size = 0;
+    PatternCollection new_patterns;
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const vector<int> &connected_vars = relevant_neighbours[pattern_var];
@@ -159,16 +161,21 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                       surpass the size limit.
                     */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        compute_pdb(task_proxy, new_pattern));
-                    max_pdb_size = max(max_pdb_size,
-                                       candidate_pdbs.back()->get_size());
+                    new_patterns.push_back(move(new_pattern));
                 }
             } else {
                 ++num_rejected;
             }
         }
     }
+
+    // The PDBs for the new patterns are independent of each other.
+    int max_pdb_size = 0;
+    for (shared_ptr<PatternDatabase> &new_pdb :
+         compute_pdbs(task_proxy, new_patterns, num_threads)) {
+        max_pdb_size = max(max_pdb_size, new_pdb->get_size());
+        candidate_pdbs.push_back(move(new_pdb));
+    }
     return max_pdb_size;
 }
 
@@ -194,6 +201,8 @@ void PatternCollectionGeneratorHillclimbing::sample_states(
 pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
     const vector<State> &samples,
     const vector<int> &samples_h_values,
+    const vector<vector<int>> &samples_pdb_h_values,
+    const vector<vector<int>> &samples_clique_h_values,
     PDBCollection &candidate_pdbs) {
     /*
       TODO: The original implementation by Haslum et al. uses A* to compute
@@ -202,53 +211,50 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
       We require that a pattern must have an improvement of at least one in
       order to be taken into account.
     */
-    int improvement = 0;
-    int best_pdb_index = -1;
-
-    // Iterate over all candidates and search for the best improving pattern/pdb
     for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
-        if (hill_climbing_timer->is_expired())
-            throw HillClimbingTimeout();
-
         const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
-        if (!pdb) {
-            /* candidate pattern is too large or has already been added to
-               the canonical heuristic. */
-            continue;
-        }
         /*
           If a candidate's size added to the current collection's size exceeds
           the maximum collection size, then forget the pdb.
         */
-        int combined_size = current_pdbs->get_size() + pdb->get_size();
-        if (combined_size > collection_max_size) {
+        if (pdb &&
+            current_pdbs->get_size() + pdb->get_size() > collection_max_size) {
             candidate_pdbs[i] = nullptr;
-            continue;
         }
+    }
 
-        /*
-          Calculate the "counting approximation" for all sample states: count
-          the number of samples for which the current pattern collection
-          heuristic would be improved if the new pattern was included into it.
-        */
-        /*
-          TODO: The original implementation by Haslum et al. uses m/t as a
-          statistical confidence interval to stop the A*-search (which they use,
-          see above) earlier.
-        */
-        int count = 0;
-        vector<PatternClique> pattern_cliques =
-            current_pdbs->get_pattern_cliques(pdb->get_pattern());
-        for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
-            const State &sample = samples[sample_id];
-            assert(utils::in_bounds(sample_id, samples_h_values));
-            int h_collection = samples_h_values[sample_id];
-            if (is_heuristic_improved(
-                    *pdb, sample, h_collection,
-                    *current_pdbs->get_pattern_databases(), pattern_cliques)) {
-                ++count;
+    /*
+      The counts of the candidates are independent of each other. Workers
+      cannot throw the timeout exception, so they skip the remaining
+      candidates once the time limit is reached and we throw afterwards.
+    */
+    vector<int> counts(candidate_pdbs.size(), 0);
+    atomic<bool> timed_out(false);
+    utils::parallel_for(
+        candidate_pdbs.size(), num_threads,
+        [&](int i) {
+            const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
+            if (!pdb || timed_out) {
+                /* candidate pattern is too large or has already been added to
+                   the canonical heuristic. */
+                return;
             }
-        }
+            if (hill_climbing_timer->is_expired()) {
+                timed_out = true;
+                return;
+            }
+            counts[i] = count_improved_samples(
+                *pdb, samples, samples_h_values, samples_pdb_h_values,
+                samples_clique_h_values);
+        });
+    if (timed_out)
+        throw HillClimbingTimeout();
+
+    // Iterate over all candidates and search for the best improving pattern/pdb
+    int improvement = 0;
+    int best_pdb_index = -1;
+    for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
+        int count = counts[i];
         if (count > improvement) {
             improvement = count;
             best_pdb_index = i;
@@ -262,9 +268,45 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
     return make_pair(improvement, best_pdb_index);
 }
 
+int PatternCollectionGeneratorHillclimbing::count_improved_samples(
+    const PatternDatabase &pdb,
+    const vector<State> &samples,
+    const vector<int> &samples_h_values,
+    const vector<vector<int>> &samples_pdb_h_values,
+    const vector<vector<int>> &samples_clique_h_values) const {
+    /*
+      Calculate the "counting approximation" for all sample states: count
+      the number of samples for which the current pattern collection
+      heuristic would be improved if the new pattern was included into it.
+    */
+    /*
+      TODO: The original implementation by Haslum et al. uses m/t as a
+      statistical confidence interval to stop the A*-search (which they use,
+      see above) earlier.
+    */
+    int count = 0;
+    vector<PatternClique> non_additive_patterns =
+        current_pdbs->get_non_additive_patterns(pdb.get_pattern());
+    for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
+        const State &sample = samples[sample_id];
+        assert(utils::in_bounds(sample_id, samples_h_values));
+        int h_collection = samples_h_values[sample_id];
+        if (is_heuristic_improved(
+                pdb, sample, h_collection,
+                samples_pdb_h_values[sample_id],
+                samples_clique_h_values[sample_id],
+                non_additive_patterns)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
 bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
     const PatternDatabase &pdb, const State &sample, int h_collection,
-    const PDBCollection &pdbs, const vector<PatternClique> &pattern_cliques) {
+    const vector<int> &pdb_h_values,
+    const vector<int> &clique_h_values,
+    const vector<PatternClique> &non_additive_patterns) const {
     const vector<int> &sample_data = sample.get_unpacked_values();
     // h_pattern: h-value of the new pattern
     int h_pattern = pdb.get_value(sample_data);
@@ -277,18 +319,18 @@ bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
     if (h_collection == numeric_limits<int>::max())
         return false;
 
-    vector<int> h_values;
-    h_values.reserve(pdbs.size());
-    for (const shared_ptr<PatternDatabase> &p : pdbs) {
-        int h = p->get_value(sample_data);
-        if (h == numeric_limits<int>::max())
-            return false;
-        h_values.push_back(h);
-    }
-    for (const PatternClique &clilque : pattern_cliques) {
-        int h_clique = 0;
-        for (PatternID pattern_id : clilque) {
-            h_clique += h_values[pattern_id];
+    /*
+      The cliques for the new pattern are subsets of the cliques of the
+      current collection, so their h-values are at most h_collection.
+    */
+    if (h_pattern == 0)
+        return false;
+
+    // All PDBs have finite h-values since h_collection is finite.
+    for (size_t clique_id = 0; clique_id < clique_h_values.size(); ++clique_id) {
+        int h_clique = clique_h_values[clique_id];
+        for (PatternID pattern_id : non_additive_patterns[clique_id]) {
+            h_clique -= pdb_h_values[pattern_id];
         }
         if (h_pattern + h_clique > h_collection) {
             /*
@@ -342,6 +384,8 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
     sampling::RandomWalkSampler sampler(task_proxy, *rng);
     vector<State> samples;
     vector<int> samples_h_values;
+    vector<vector<int>> samples_pdb_h_values;
+    vector<vector<int>> samples_clique_h_values;
 
     try {
         while (true) {
@@ -364,13 +408,30 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
 
             samples.clear();
             samples_h_values.clear();
+            samples_pdb_h_values.clear();
+            samples_clique_h_values.clear();
             sample_states(sampler, init_h, samples);
+            /*
+              Look up the h-values of the current collection once per sample
+              instead of once per sample and candidate. This also unpacks
+              the samples before they are shared between threads.
+            */
             for (const State &sample : samples) {
-                samples_h_values.push_back(current_pdbs->get_value(sample));
+                int h = current_pdbs->get_value(sample);
+                samples_h_values.push_back(h);
+                samples_pdb_h_values.push_back(
+                    current_pdbs->get_pdb_values(sample));
+                // Clique values are only used for samples with finite h.
+                samples_clique_h_values.push_back(
+                    h == numeric_limits<int>::max() ? vector<int>() :
+                    current_pdbs->get_clique_values(
+                        samples_pdb_h_values.back()));
             }
 
             pair<int, int> improvement_and_index =
-                find_best_improving_pdb(samples, samples_h_values, candidate_pdbs);
+                find_best_improving_pdb(
+                    samples, samples_h_values, samples_pdb_h_values,
+                    samples_clique_h_values, candidate_pdbs);
             int improvement = improvement_and_index.first;
             int best_pdb_index = improvement_and_index.second;
 
@@ -552,7 +613,7 @@ void add_hillclimbing_options(plugins::Feature &feature) {
         "infinity",
         plugins::Bounds("0.0", "infinity"));
     utils::add_rng_options(feature);
-    add_generator_options_to_feature(feature);
+    add_collection_generator_options_to_feature(feature);
 }
 
 void check_hillclimbing_options(
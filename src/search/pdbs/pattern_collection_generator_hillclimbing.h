@@ -78,24 +78,49 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
       Searches for the best improving pdb in candidate_pdbs according to the
       counting approximation and the given samples. Returns the improvement and
       the index of the best pdb in candidate_pdbs.
+
+      For each sample, the h-values of the current collection, of its PDBs
+      and of its pattern cliques are computed once per iteration and cached
+      in samples_h_values, samples_pdb_h_values and samples_clique_h_values
+      (see IncrementalCanonicalPDBs). The candidates are evaluated with up
+      to num_threads threads.
     */
     std::pair<int, int> find_best_improving_pdb(
         const std::vector<State> &samples,
         const std::vector<int> &samples_h_values,
+        const std::vector<std::vector<int>> &samples_pdb_h_values,
+        const std::vector<std::vector<int>> &samples_clique_h_values,
         PDBCollection &candidate_pdbs);
 
+    /*
+      Returns the number of samples for which adding the PDB to the current
+      collection improves the heuristic (see is_heuristic_improved).
+    */
+    int count_improved_samples(
+        const PatternDatabase &pdb,
+        const std::vector<State> &samples,
+        const std::vector<int> &samples_h_values,
+        const std::vector<std::vector<int>> &samples_pdb_h_values,
+        const std::vector<std::vector<int>> &samples_clique_h_values) const;
+
     /*
       Returns true iff the h-value of the new pattern (from pdb) plus the
       h-value of all pattern cliques from the current pattern
       collection heuristic if the new pattern was added to it is greater than
       the h-value of the current pattern collection.
+
+      The h-value of such a clique is the cached h-value of a clique of the
+      current collection (clique_h_values) minus the cached h-values
+      (pdb_h_values) of its patterns that are not additive with the new
+      pattern (non_additive_patterns).
     */
     bool is_heuristic_improved(
         const PatternDatabase &pdb,
         const State &sample,
         int h_collection,
-        const PDBCollection &pdbs,
-        const std::vector<PatternClique> &pattern_cliques);
+        const std::vector<int> &pdb_h_values,
+        const std::vector<int> &clique_h_values,
+        const std::vector<PatternClique> &non_additive_patterns) const;
 
     /*
       This is the core algorithm of this class. The initial PDB collection
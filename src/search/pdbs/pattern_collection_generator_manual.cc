@@ -27,7 +27,7 @@ PatternCollectionInformation PatternCollectionGeneratorManual::compute_patterns(
         log << "Manual pattern collection: " << *patterns << endl;
     }
     TaskProxy task_proxy(*task);
-    return PatternCollectionInformation(task_proxy, patterns, log);
+    return PatternCollectionInformation(task_proxy, patterns, log, num_threads);
 }
 
 class PatternCollectionGeneratorManualFeature : public plugins::TypedFeature<PatternCollectionGenerator, PatternCollectionGeneratorManual> {
@@ -37,7 +37,7 @@ public:
             "patterns",
             "list of patterns (which are lists of variable numbers of the planning "
             "task).");
-        add_generator_options_to_feature(*this);
+        add_collection_generator_options_to_feature(*this);
     }
 };
 
@@ -1,6 +1,7 @@
 #include "pattern_collection_generator_multiple.h"
 
 #include "pattern_database.h"
+#include "pattern_database_factory.h"
 #include "utils.h"
 
 #include "../plugins/plugin.h"
@@ -78,6 +79,7 @@ unordered_set<int> PatternCollectionGeneratorMultiple::get_blacklisted_variables
 void PatternCollectionGeneratorMultiple::handle_generated_pattern(
     PatternInformation &&pattern_info,
     set<Pattern> &generated_patterns,
+    PatternCollection &collection,
     shared_ptr<PDBCollection> &generated_pdbs,
     const utils::CountdownTimer &timer) {
     const Pattern &pattern = pattern_info.get_pattern();
@@ -86,12 +88,21 @@ void PatternCollectionGeneratorMultiple::handle_generated_pattern(
     }
     if (generated_patterns.insert(move(pattern)).second) {
         /*
-          compute_pattern generated a new pattern. Create/retrieve corresponding
-          PDB, update collection size and reset time_point_of_last_new_pattern.
+          compute_pattern generated a new pattern. Retrieve the corresponding
+          PDB if it has been computed already, update collection size and
+          reset time_point_of_last_new_pattern. Missing PDBs are computed
+          in parallel at the end.
         */
         time_point_of_last_new_pattern = timer.get_elapsed_time();
-        shared_ptr<PatternDatabase> pdb = pattern_info.get_pdb();
-        remaining_collection_size -= pdb->get_size();
+        shared_ptr<PatternDatabase> pdb = nullptr;
+        if (pattern_info.has_pdb()) {
+            pdb = pattern_info.get_pdb();
+            remaining_collection_size -= pdb->get_size();
+        } else {
+            remaining_collection_size -=
+                compute_pdb_size(pattern_info.get_task_proxy(), pattern);
+        }
+        collection.push_back(pattern);
         generated_pdbs->push_back(move(pdb));
     }
 }
@@ -190,8 +201,12 @@ PatternCollectionInformation PatternCollectionGeneratorMultiple::compute_pattern
 
     initialize(task);
 
-    // Collect all unique patterns and their PDBs.
+    /*
+      Collect all unique patterns and their PDBs. PDBs that compute_pattern
+      did not compute are missing (nullptr) in generated_pdbs.
+    */
     set<Pattern> generated_patterns;
+    PatternCollection collection;
     shared_ptr<PDBCollection> generated_pdbs = make_shared<PDBCollection>();
 
     shared_ptr<utils::RandomNumberGenerator> pattern_computation_rng =
@@ -218,6 +233,7 @@ PatternCollectionInformation PatternCollectionGeneratorMultiple::compute_pattern
         handle_generated_pattern(
             move(pattern_info),
             generated_patterns,
+            collection,
             generated_pdbs,
             timer);
 
@@ -233,6 +249,20 @@ PatternCollectionInformation PatternCollectionGeneratorMultiple::compute_pattern
         assert(utils::in_bounds(goal_index, goals));
     }
 
+    PatternCollection missing_patterns;
+    vector<int> missing_indices;
+    for (size_t i = 0; i < generated_pdbs->size(); ++i) {
+        if (!(*generated_pdbs)[i]) {
+            missing_patterns.push_back(collection[i]);
+            missing_indices.push_back(i);
+        }
+    }
+    PDBCollection missing_pdbs =
+        compute_pdbs(task_proxy, missing_patterns, num_threads);
+    for (size_t i = 0; i < missing_indices.size(); ++i) {
+        (*generated_pdbs)[missing_indices[i]] = move(missing_pdbs[i]);
+    }
+
     PatternCollectionInformation result = get_pattern_collection_info(
         task_proxy, generated_pdbs, log);
     if (log.is_at_least_normal()) {
@@ -322,7 +352,5 @@ void add_multiple_options_to_feature(plugins::Feature &feature) {
         "generation is terminated already the first time stagnation_limit is "
         "hit.",
         "true");
-    add_generator_options_to_feature(feature);
-    utils::add_rng_options(feature);
 }
 }
@@ -54,6 +54,7 @@ class PatternCollectionGeneratorMultiple : public PatternCollectionGenerator {
     void handle_generated_pattern(
         PatternInformation &&pattern_info,
         std::set<Pattern> &generated_patterns,
+        PatternCollection &collection,
         std::shared_ptr<PDBCollection> &generated_pdbs,
         const utils::CountdownTimer &timer);
     bool collection_size_limit_reached() const;
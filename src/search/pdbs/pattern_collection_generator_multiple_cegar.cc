@@ -6,6 +6,7 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
+#include "../utils/rng_options.h"
 
 using namespace std;
 
@@ -52,6 +53,8 @@ public:
             "the algorithms.");
 
         add_multiple_options_to_feature(*this);
+        add_generator_options_to_feature(*this);
+        utils::add_rng_options(*this);
         add_cegar_wildcard_option_to_feature(*this);
 
         add_cegar_implementation_notes_to_feature(*this);
@@ -7,6 +7,7 @@
 
 #include "../plugins/plugin.h"
 #include "../utils/logging.h"
+#include "../utils/rng_options.h"
 
 #include <vector>
 
@@ -65,6 +66,8 @@ public:
             "in the paper. See below for descriptions of the algorithms.");
 
         add_multiple_options_to_feature(*this);
+        add_collection_generator_options_to_feature(*this);
+        utils::add_rng_options(*this);
         add_random_pattern_bidirectional_option_to_feature(*this);
 
         add_random_pattern_implementation_notes_to_feature(*this);
@@ -281,7 +281,7 @@ PatternCollectionInformation PatternCollectionGeneratorSystematic::compute_patte
     } else {
         build_patterns_naive(task_proxy);
     }
-    return PatternCollectionInformation(task_proxy, patterns, log);
+    return PatternCollectionInformation(task_proxy, patterns, log, num_threads);
 }
 
 class PatternCollectionGeneratorSystematicFeature : public plugins::TypedFeature<PatternCollectionGenerator, PatternCollectionGeneratorSystematic> {
@@ -311,7 +311,7 @@ public:
             "Only consider the union of two disjoint patterns if the union has "
             "more information than the individual patterns.",
             "true");
-        add_generator_options_to_feature(*this);
+        add_collection_generator_options_to_feature(*this);
     }
 };
 
@@ -19,12 +19,14 @@ namespace pdbs {
 PatternCollectionInformation::PatternCollectionInformation(
     const TaskProxy &task_proxy,
     const shared_ptr<PatternCollection> &patterns,
-    utils::LogProxy &log)
+    utils::LogProxy &log,
+    int num_threads)
     : task_proxy(task_proxy),
       patterns(patterns),
       pdbs(nullptr),
       pattern_cliques(nullptr),
-      log(log) {
+      log(log),
+      num_threads(num_threads) {
     assert(patterns);
     validate_and_normalize_patterns(task_proxy, *patterns, log);
 }
@@ -63,12 +65,8 @@ void PatternCollectionInformation::create_pdbs_if_missing() {
         if (log.is_at_least_normal()) {
             log << "Computing PDBs for pattern collection..." << endl;
         }
-        pdbs = make_shared<PDBCollection>();
-        for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb =
-                compute_pdb(task_proxy, pattern);
-            pdbs->push_back(pdb);
-        }
+        pdbs = make_shared<PDBCollection>(
+            compute_pdbs(task_proxy, *patterns, num_threads));
         if (log.is_at_least_normal()) {
             log << "Done computing PDBs for pattern collection: "
                 << timer << endl;
@@ -30,6 +30,8 @@ class PatternCollectionInformation {
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<std::vector<PatternClique>> pattern_cliques;
     utils::LogProxy &log;
+    // Number of threads used to compute missing PDBs.
+    int num_threads;
 
     void create_pdbs_if_missing();
     void create_pattern_cliques_if_missing();
@@ -39,7 +41,8 @@ public:
     PatternCollectionInformation(
         const TaskProxy &task_proxy,
         const std::shared_ptr<PatternCollection> &patterns,
-        utils::LogProxy &log);
+        utils::LogProxy &log,
+        int num_threads = 1);
     ~PatternCollectionInformation() = default;
 
     void set_pdbs(const std::shared_ptr<PDBCollection> &pdbs);
@@ -4,7 +4,9 @@
 
 #include "../utils/logging.h"
 #include "../utils/math.h"
+#include "../utils/memory_mapped_file.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <limits>
@@ -54,23 +56,70 @@ int Projection::unrank(int index, int var) const {
     return temp % domain_sizes[var];
 }
 
+static int compute_bytes_per_value(const vector<int> &distances) {
+    int max_finite_distance = 0;
+    for (int distance : distances) {
+        if (distance != numeric_limits<int>::max())
+            max_finite_distance = max(max_finite_distance, distance);
+    }
+    // The largest value of each type is reserved for dead ends.
+    if (max_finite_distance < numeric_limits<uint8_t>::max())
+        return 1;
+    else if (max_finite_distance < numeric_limits<uint16_t>::max())
+        return 2;
+    else
+        return 4;
+}
+
+template<typename T>
+static void store_distances(const vector<int> &distances, void *data) {
+    T *values = static_cast<T *>(data);
+    for (size_t i = 0; i < distances.size(); ++i) {
+        values[i] = distances[i] == numeric_limits<int>::max() ?
+            numeric_limits<T>::max() : distances[i];
+    }
+}
+
 PatternDatabase::PatternDatabase(
     Projection &&projection,
-    vector<int> &&distances)
+    const vector<int> &distances)
     : projection(move(projection)),
-      distances(move(distances)) {
+      bytes_per_value(compute_bytes_per_value(distances)),
+      owned_distances(
+          (distances.size() * bytes_per_value + sizeof(uint32_t) - 1) /
+          sizeof(uint32_t)),
+      distances(owned_distances.data()) {
+    void *data = owned_distances.data();
+    if (bytes_per_value == 1) {
+        store_distances<uint8_t>(distances, data);
+    } else if (bytes_per_value == 2) {
+        store_distances<uint16_t>(distances, data);
+    } else {
+        store_distances<int>(distances, data);
+    }
 }
 
-int PatternDatabase::get_value(const vector<int> &state) const {
-    return distances[projection.rank(state)];
+PatternDatabase::PatternDatabase(
+    Projection &&projection,
+    const shared_ptr<const utils::MemoryMappedFile> &mapped_file,
+    const byte *distances,
+    int bytes_per_value)
+    : projection(move(projection)),
+      bytes_per_value(bytes_per_value),
+      mapped_file(mapped_file),
+      distances(distances) {
+    assert(bytes_per_value == 1 || bytes_per_value == 2 ||
+           bytes_per_value == 4);
 }
 
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
-    for (size_t i = 0; i < distances.size(); ++i) {
-        if (distances[i] != numeric_limits<int>::max()) {
-            sum += distances[i];
+    int num_states = get_size();
+    for (int i = 0; i < num_states; ++i) {
+        int distance = get_distance(i);
+        if (distance != numeric_limits<int>::max()) {
+            sum += distance;
             ++size;
         }
     }
@@ -5,8 +5,17 @@
 
 #include "../task_proxy.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
 #include <vector>
 
+namespace utils {
+class MemoryMappedFile;
+}
+
 namespace pdbs {
 class Projection {
     Pattern pattern;
@@ -42,15 +51,67 @@ class PatternDatabase {
     Projection projection;
 
     /*
-      final h-values for abstract-states.
-      dead-ends are represented by numeric_limits<int>::max()
+      final h-values for abstract-states, stored with 1, 2 or 4 bytes per
+      value, depending on the largest finite h-value. Dead-ends are
+      represented by the largest value of the respective type.
+
+      The h-values are either owned by the PDB or stored in a
+      memory-mapped file loaded from the PDB cache (see pdb_cache.h).
+      Owned values are stored in 4-byte words to guarantee alignment.
     */
-    std::vector<int> distances;
+    int bytes_per_value;
+    std::vector<std::uint32_t> owned_distances;
+    std::shared_ptr<const utils::MemoryMappedFile> mapped_file;
+    const void *distances;
+
+    template<typename T>
+    static int convert_distance(T value) {
+        return value == std::numeric_limits<T>::max() ?
+               std::numeric_limits<int>::max() : value;
+    }
 public:
     PatternDatabase(
         Projection &&projection,
-        std::vector<int> &&distances);
-    int get_value(const std::vector<int> &state) const;
+        const std::vector<int> &distances);
+    /*
+      Use h-values stored in a memory-mapped file in the format returned
+      by get_distance_bytes().
+    */
+    PatternDatabase(
+        Projection &&projection,
+        const std::shared_ptr<const utils::MemoryMappedFile> &mapped_file,
+        const std::byte *distances,
+        int bytes_per_value);
+    /*
+      Copies would point into the h-values owned by the original. Moving
+      keeps the buffer of owned_distances, so moved PDBs remain valid.
+    */
+    PatternDatabase(const PatternDatabase &) = delete;
+    PatternDatabase &operator=(const PatternDatabase &) = delete;
+    PatternDatabase(PatternDatabase &&) = default;
+    PatternDatabase &operator=(PatternDatabase &&) = default;
+
+    int get_value(const std::vector<int> &state) const {
+        return get_distance(projection.rank(state));
+    }
+
+    // Return the h-value of the abstract state with the given rank.
+    int get_distance(int index) const {
+        switch (bytes_per_value) {
+        case 1:
+            return convert_distance(
+                static_cast<const std::uint8_t *>(distances)[index]);
+        case 2:
+            return convert_distance(
+                static_cast<const std::uint16_t *>(distances)[index]);
+        default:
+            return static_cast<const int *>(distances)[index];
+        }
+    }
+
+    const Projection &get_projection() const {
+        return projection;
+    }
 
     const Pattern &get_pattern() const {
         return projection.get_pattern();
@@ -61,6 +122,16 @@ public:
         return projection.get_num_abstract_states();
     }
 
+    int get_bytes_per_value() const {
+        return bytes_per_value;
+    }
+
+    std::span<const std::byte> get_distance_bytes() const {
+        return std::span<const std::byte>(
+            static_cast<const std::byte *>(distances),
+            static_cast<std::size_t>(get_size()) * bytes_per_value);
+    }
+
     /*
       Return the average h-value over all states, where dead-ends are
       ignored (they neither increase the sum of all h-values nor the
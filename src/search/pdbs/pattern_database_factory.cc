@@ -3,20 +3,30 @@
 #include "abstract_operator.h"
 #include "match_tree.h"
 #include "pattern_database.h"
+#include "pdb_cache.h"
 
 #include "../algorithms/priority_queues.h"
 #include "../task_utils/task_properties.h"
+#include "../utils/logging.h"
 #include "../utils/math.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <limits>
 #include <vector>
 
 using namespace std;
 
 namespace pdbs {
+/*
+  Largest operator cost for which we compute distances with one bucket
+  per distance instead of a priority queue.
+*/
+static const int MAX_COST_FOR_LAYERS = 1000;
+
 class PatternDatabaseFactory {
     const TaskProxy &task_proxy;
     VariablesProxy variables;
@@ -93,6 +103,13 @@ class PatternDatabaseFactory {
 
     void compute_distances(const MatchTree &match_tree, bool compute_plan);
 
+    /*
+      Compute the same distances as compute_distances() with a bucket for
+      each distance, processing each distance layer in one sweep. Only
+      used if all abstract operator costs are at most max_cost.
+    */
+    void compute_distances_by_layers(const MatchTree &match_tree, int max_cost);
+
     void compute_plan(
         const MatchTree &match_tree,
         const shared_ptr<utils::RandomNumberGenerator> &rng,
@@ -292,6 +309,90 @@ bool PatternDatabaseFactory::is_goal_state(int state_index) const {
     return true;
 }
 
+void PatternDatabaseFactory::compute_distances_by_layers(
+    const MatchTree &match_tree, int max_cost) {
+    int num_states = projection.get_num_abstract_states();
+    distances.assign(num_states, numeric_limits<int>::max());
+
+    // Store the data of the inner loop in flat arrays.
+    vector<int> hash_effects;
+    vector<int> costs;
+    hash_effects.reserve(abstract_ops.size());
+    costs.reserve(abstract_ops.size());
+    for (const AbstractOperator &op : abstract_ops) {
+        hash_effects.push_back(op.get_hash_effect());
+        costs.push_back(op.get_cost());
+    }
+
+    /*
+      States with tentative distance d are stored in layers[d % num_layers].
+      Since no operator costs more than max_cost, all states in the queue
+      have a distance between d and d + max_cost while expanding layer d.
+    */
+    int num_layers = max_cost + 1;
+    vector<vector<int>> layers(num_layers);
+    /*
+      Instead of testing all abstract states, we enumerate the goal states
+      by combining the goal values with all values of the other variables.
+    */
+    vector<int> &goal_states = layers[0];
+    vector<bool> is_goal_variable(projection.get_pattern().size(), false);
+    int goal_index = 0;
+    for (const FactPair &goal : abstract_goals) {
+        is_goal_variable[goal.var] = true;
+        goal_index += goal.value * projection.get_multiplier(goal.var);
+    }
+    goal_states.push_back(goal_index);
+    for (size_t var = 0; var < is_goal_variable.size(); ++var) {
+        if (!is_goal_variable[var]) {
+            int multiplier = projection.get_multiplier(var);
+            int domain_size =
+                variables[projection.get_pattern()[var]].get_domain_size();
+            int num_goal_states = goal_states.size();
+            for (int value = 1; value < domain_size; ++value) {
+                for (int i = 0; i < num_goal_states; ++i) {
+                    goal_states.push_back(goal_states[i] + value * multiplier);
+                }
+            }
+        }
+    }
+    for (int state_index : goal_states) {
+        distances[state_index] = 0;
+    }
+    int64_t num_queued_states = goal_states.size();
+
+    vector<int> layer;
+    vector<int> applicable_operator_ids;
+    for (int distance = 0; num_queued_states > 0; ++distance) {
+        vector<int> &bucket = layers[distance % num_layers];
+        // Zero-cost operators add states to the layer that is expanded.
+        while (!bucket.empty()) {
+            layer.clear();
+            swap(layer, bucket);
+            num_queued_states -= layer.size();
+            for (int state_index : layer) {
+                if (distances[state_index] != distance) {
+                    // The state has been reached with a lower distance.
+                    continue;
+                }
+                applicable_operator_ids.clear();
+                match_tree.get_applicable_operator_ids(
+                    state_index, applicable_operator_ids);
+                for (int op_id : applicable_operator_ids) {
+                    int predecessor = state_index + hash_effects[op_id];
+                    int alternative_cost = distance + costs[op_id];
+                    if (alternative_cost < distances[predecessor]) {
+                        distances[predecessor] = alternative_cost;
+                        layers[alternative_cost % num_layers].push_back(
+                            predecessor);
+                        ++num_queued_states;
+                    }
+                }
+            }
+        }
+    }
+}
+
 void PatternDatabaseFactory::compute_distances(
     const MatchTree &match_tree, bool compute_plan) {
     distances.reserve(projection.get_num_abstract_states());
@@ -423,20 +524,88 @@ PatternDatabaseFactory::PatternDatabaseFactory(
     compute_abstract_operators(operator_costs);
     unique_ptr<MatchTree> match_tree = compute_match_tree();
     compute_abstract_goals();
-    compute_distances(*match_tree, compute_plan);
+    int max_cost = 0;
+    for (const AbstractOperator &op : abstract_ops) {
+        max_cost = max(max_cost, op.get_cost());
+    }
+    /*
+      The plan extracted by compute_plan() depends on the order in which
+      Dijkstra's algorithm expands states, so we only use the layered
+      computation for PDBs without plans.
+    */
+    if (!compute_plan && max_cost <= MAX_COST_FOR_LAYERS) {
+        compute_distances_by_layers(*match_tree, max_cost);
+    } else {
+        compute_distances(*match_tree, compute_plan);
+    }
 
     if (compute_plan) {
         this->compute_plan(*match_tree, rng, compute_wildcard_plan);
     }
 }
 
+/*
+  Like compute_pdb(), but set cache_write_failed instead of logging, so
+  that it can be called from several threads.
+*/
+static shared_ptr<PatternDatabase> compute_pdb_using_cache(
+    const TaskProxy &task_proxy,
+    const Pattern &pattern,
+    const vector<int> &operator_costs,
+    const shared_ptr<utils::RandomNumberGenerator> &rng,
+    bool &cache_write_failed) {
+    shared_ptr<PatternDatabase> pdb =
+        load_pdb_from_cache(task_proxy, pattern, operator_costs);
+    if (!pdb) {
+        PatternDatabaseFactory pdb_factory(task_proxy, pattern, operator_costs, false, rng);
+        pdb = pdb_factory.extract_pdb();
+        cache_write_failed = !save_pdb_to_cache(task_proxy, operator_costs, *pdb);
+    }
+    return pdb;
+}
+
+static void log_cache_write_failure(const Pattern &pattern) {
+    utils::g_log << "Could not write PDB for pattern " << pattern
+                 << " to the PDB cache" << endl;
+}
+
 shared_ptr<PatternDatabase> compute_pdb(
     const TaskProxy &task_proxy,
     const Pattern &pattern,
     const vector<int> &operator_costs,
     const shared_ptr<utils::RandomNumberGenerator> &rng) {
-    PatternDatabaseFactory pdb_factory(task_proxy, pattern, operator_costs, false, rng);
-    return pdb_factory.extract_pdb();
+    bool cache_write_failed = false;
+    shared_ptr<PatternDatabase> pdb = compute_pdb_using_cache(
+        task_proxy, pattern, operator_costs, rng, cache_write_failed);
+    if (cache_write_failed) {
+        log_cache_write_failure(pattern);
+    }
+    return pdb;
+}
+
+PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    int num_threads,
+    const vector<int> &operator_costs) {
+    PDBCollection pdbs(patterns.size());
+    // Not vector<bool>, whose elements cannot be written concurrently.
+    vector<char> cache_write_failed(patterns.size(), false);
+    utils::parallel_for(
+        patterns.size(), num_threads,
+        [&](int i) {
+            bool failed = false;
+            pdbs[i] = compute_pdb_using_cache(
+                task_proxy, patterns[i], operator_costs, nullptr, failed);
+            cache_write_failed[i] = failed;
+        });
+    // Log on the calling thread, since the log is not thread-safe.
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        if (cache_write_failed[i]) {
+            log_cache_write_failure(patterns[i]);
+        }
+    }
+    return pdbs;
 }
 
 tuple<shared_ptr<PatternDatabase>, vector<vector<OperatorID>>>
@@ -22,6 +22,9 @@ namespace pdbs {
   If operator_costs is given, it must contain one integer for each operator
   of the task, specifying the cost that should be considered for that operator
   instead of its original cost.
+
+  If the PDB cache is enabled (see pdb_cache.h), the PDB is loaded from
+  the cache if possible and stored in the cache otherwise.
 */
 extern std::shared_ptr<PatternDatabase> compute_pdb(
     const TaskProxy &task_proxy,
@@ -29,6 +32,17 @@ extern std::shared_ptr<PatternDatabase> compute_pdb(
     const std::vector<int> &operator_costs = std::vector<int>(),
     const std::shared_ptr<utils::RandomNumberGenerator> &rng = nullptr);
 
+/*
+  Compute PDBs for all given patterns like compute_pdb() above, using up
+  to num_threads threads. The result does not depend on the number of
+  threads.
+*/
+extern PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy,
+    const PatternCollection &patterns,
+    int num_threads,
+    const std::vector<int> &operator_costs = std::vector<int>());
+
 /*
   In addition to computing a PDB for the given task and pattern like
   compute_pdb() above, also compute an abstract plan along.
@@ -8,7 +8,8 @@ using namespace std;
 
 namespace pdbs {
 PatternCollectionGenerator::PatternCollectionGenerator(const plugins::Options &opts)
-    : log(utils::get_log_from_options(opts)) {
+    : log(utils::get_log_from_options(opts)),
+      num_threads(opts.get<int>("threads", 1)) {
 }
 
 PatternCollectionInformation PatternCollectionGenerator::generate(
@@ -46,6 +47,18 @@ void add_generator_options_to_feature(plugins::Feature &feature) {
     utils::add_log_options_to_feature(feature);
 }
 
+void add_collection_generator_options_to_feature(plugins::Feature &feature) {
+    feature.add_option<int>(
+        "threads",
+        "number of threads for computing PDBs that do not depend on each "
+        "other and, in hill climbing, for evaluating candidate patterns. "
+        "The resulting pattern collection does not depend on the number of "
+        "threads.",
+        "1",
+        plugins::Bounds("1", "infinity"));
+    add_generator_options_to_feature(feature);
+}
+
 static class PatternCollectionGeneratorCategoryPlugin : public plugins::TypedCategoryPlugin<PatternCollectionGenerator> {
 public:
     PatternCollectionGeneratorCategoryPlugin() : TypedCategoryPlugin("PatternCollectionGenerator") {
@@ -28,6 +28,12 @@ class PatternCollectionGenerator {
         const std::shared_ptr<AbstractTask> &task) = 0;
 protected:
     mutable utils::LogProxy log;
+    /*
+      Number of threads for computing independent PDBs. Generators that
+      compute all PDBs themselves (the CEGAR-based ones) have no "threads"
+      option and use one thread.
+    */
+    const int num_threads;
 public:
     explicit PatternCollectionGenerator(const plugins::Options &opts);
     virtual ~PatternCollectionGenerator() = default;
@@ -50,6 +56,8 @@ public:
 };
 
 extern void add_generator_options_to_feature(plugins::Feature &feature);
+extern void add_collection_generator_options_to_feature(
+    plugins::Feature &feature);
 }
 
 #endif
@@ -43,6 +43,10 @@ public:
 
     const Pattern &get_pattern() const;
     std::shared_ptr<PatternDatabase> get_pdb();
+
+    bool has_pdb() const {
+        return pdb != nullptr;
+    }
 };
 }
 
@@ -0,0 +1,177 @@
+#include "pdb_cache.h"
+
+#include "pattern_database.h"
+
+#include "../utils/hash.h"
+#include "../utils/memory_mapped_file.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+namespace pdbs {
+/*
+  A cache file consists of 32-bit words: MAGIC, FORMAT_VERSION, the two
+  halves of the hash, the pattern size, the pattern, the number of
+  abstract states and the number of bytes per h-value. The h-values
+  follow in the format of PatternDatabase::get_distance_bytes().
+*/
+static const uint32_t MAGIC = 0x46445042;
+static const uint32_t FORMAT_VERSION = 2;
+
+static filesystem::path get_cache_directory() {
+    const char *directory = getenv("DOWNWARD_PDB_CACHE_DIR");
+    if (!directory)
+        return filesystem::path();
+    return filesystem::path(directory);
+}
+
+static uint64_t compute_pdb_hash(
+    const TaskProxy &task_proxy, const Pattern &pattern,
+    const vector<int> &operator_costs) {
+    VariablesProxy variables = task_proxy.get_variables();
+    vector<int> variable_to_index(variables.size(), -1);
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        variable_to_index[pattern[i]] = i;
+    }
+
+    utils::HashState hash_state;
+    utils::feed(hash_state, pattern);
+    for (int var : pattern) {
+        utils::feed(hash_state, variables[var].get_domain_size());
+    }
+    auto feed_projected_facts = [&](const auto &facts) {
+            for (FactProxy fact : facts) {
+                FactPair fact_pair = fact.get_pair();
+                int index = variable_to_index[fact_pair.var];
+                if (index != -1) {
+                    utils::feed(hash_state, index);
+                    utils::feed(hash_state, fact_pair.value);
+                }
+            }
+            // Separate the lists of facts.
+            utils::feed(hash_state, -1);
+        };
+    feed_projected_facts(task_proxy.get_goals());
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        int cost = operator_costs.empty() ?
+            op.get_cost() : operator_costs[op.get_id()];
+        utils::feed(hash_state, cost);
+        feed_projected_facts(op.get_preconditions());
+        for (EffectProxy effect : op.get_effects()) {
+            int index = variable_to_index[effect.get_fact().get_variable().get_id()];
+            if (index != -1) {
+                utils::feed(hash_state, index);
+                utils::feed(hash_state, effect.get_fact().get_value());
+            }
+        }
+        utils::feed(hash_state, -1);
+    }
+    return hash_state.get_hash64();
+}
+
+static filesystem::path get_cache_file_path(
+    const filesystem::path &directory, uint64_t hash) {
+    ostringstream name;
+    name << hex << setw(16) << setfill('0') << hash << ".pdb";
+    return directory / name.str();
+}
+
+static vector<uint32_t> create_header(uint64_t hash, const Pattern &pattern) {
+    vector<uint32_t> header = {
+        MAGIC, FORMAT_VERSION,
+        static_cast<uint32_t>(hash), static_cast<uint32_t>(hash >> 32),
+        static_cast<uint32_t>(pattern.size())};
+    header.insert(header.end(), pattern.begin(), pattern.end());
+    return header;
+}
+
+shared_ptr<PatternDatabase> load_pdb_from_cache(
+    const TaskProxy &task_proxy, const Pattern &pattern,
+    const vector<int> &operator_costs) {
+    filesystem::path directory = get_cache_directory();
+    if (directory.empty())
+        return nullptr;
+    uint64_t hash = compute_pdb_hash(task_proxy, pattern, operator_costs);
+    shared_ptr<const utils::MemoryMappedFile> file =
+        utils::MemoryMappedFile::open(get_cache_file_path(directory, hash));
+    if (!file)
+        return nullptr;
+
+    Projection projection(task_proxy, pattern);
+    int num_abstract_states = projection.get_num_abstract_states();
+    vector<uint32_t> header = create_header(hash, pattern);
+    header.push_back(num_abstract_states);
+    // The header ends with the number of bytes per h-value.
+    size_t header_bytes = (header.size() + 1) * sizeof(uint32_t);
+    /*
+      Files with a different header or size belong to another pattern
+      with the same hash or were written by another version of the
+      planner. We ignore them.
+    */
+    const uint32_t *file_words =
+        reinterpret_cast<const uint32_t *>(file->get_data());
+    if (file->get_size() < header_bytes ||
+        !equal(header.begin(), header.end(), file_words)) {
+        return nullptr;
+    }
+    int bytes_per_value = file_words[header.size()];
+    if ((bytes_per_value != 1 && bytes_per_value != 2 &&
+         bytes_per_value != 4) ||
+        file->get_size() !=
+        header_bytes + static_cast<size_t>(num_abstract_states) * bytes_per_value) {
+        return nullptr;
+    }
+    const byte *distances =
+        reinterpret_cast<const byte *>(file->get_data() + header_bytes);
+    return make_shared<PatternDatabase>(
+        move(projection), file, distances, bytes_per_value);
+}
+
+bool save_pdb_to_cache(
+    const TaskProxy &task_proxy, const vector<int> &operator_costs,
+    const PatternDatabase &pdb) {
+    filesystem::path directory = get_cache_directory();
+    if (directory.empty())
+        return true;
+    const Pattern &pattern = pdb.get_pattern();
+    uint64_t hash = compute_pdb_hash(task_proxy, pattern, operator_costs);
+    filesystem::path path = get_cache_file_path(directory, hash);
+    vector<uint32_t> header = create_header(hash, pattern);
+    header.push_back(pdb.get_size());
+    header.push_back(pdb.get_bytes_per_value());
+    span<const byte> distances = pdb.get_distance_bytes();
+
+    /*
+      Write to a temporary file first and rename it afterwards, so that
+      concurrent planner runs and threads never see incomplete files.
+    */
+    filesystem::path tmp_path = path;
+    tmp_path += "." + to_string(utils::get_process_id()) + "." +
+        to_string(std::hash<thread::id>()(this_thread::get_id())) + ".tmp";
+    error_code error;
+    filesystem::create_directories(directory, error);
+    ofstream file(tmp_path, ios::binary);
+    file.write(reinterpret_cast<const char *>(header.data()),
+               header.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char *>(distances.data()),
+               distances.size());
+    file.close();
+    if (file) {
+        filesystem::rename(tmp_path, path, error);
+    }
+    if (!file || error) {
+        filesystem::remove(tmp_path, error);
+        return false;
+    }
+    return true;
+}
+}
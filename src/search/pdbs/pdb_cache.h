@@ -0,0 +1,42 @@
+#ifndef PDBS_PDB_CACHE_H
+#define PDBS_PDB_CACHE_H
+
+#include "types.h"
+
+#include "../task_proxy.h"
+
+#include <memory>
+#include <vector>
+
+namespace pdbs {
+/*
+  Cache of PDBs on disk that lets later planner runs (e.g., the other
+  configurations of a portfolio) reuse PDBs instead of computing them
+  again. The cache is only used if the environment variable
+  DOWNWARD_PDB_CACHE_DIR names a directory for the cache files. The
+  driver has no option for it: the search processes of all portfolio
+  components inherit the variable from the environment of the driver.
+
+  A cached PDB is identified by a hash of everything its h-values depend
+  on: the pattern, the domains of the pattern variables, the goals and
+  the projections of all operators onto the pattern together with their
+  costs. Cached h-values are memory-mapped read-only, so loading a PDB
+  does not copy them.
+*/
+extern std::shared_ptr<PatternDatabase> load_pdb_from_cache(
+    const TaskProxy &task_proxy,
+    const Pattern &pattern,
+    const std::vector<int> &operator_costs);
+
+/*
+  Return false if the cache is enabled but the PDB could not be written.
+  The function does not log anything because it may run in several
+  threads at the same time (see compute_pdbs()).
+*/
+extern bool save_pdb_to_cache(
+    const TaskProxy &task_proxy,
+    const std::vector<int> &operator_costs,
+    const PatternDatabase &pdb);
+}
+
+#endif
@@ -24,6 +24,10 @@ PDBHeuristic::PDBHeuristic(const plugins::Options &opts)
       pdb(get_pdb_from_options(task, opts)) {
 }
 
+shared_ptr<Evaluator> PDBHeuristic::create_thread_copy() const {
+    return make_shared<PDBHeuristic>(*this);
+}
+
 int PDBHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     int h = pdb->get_value(state.get_unpacked_values());
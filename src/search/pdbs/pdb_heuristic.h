@@ -23,6 +23,8 @@ public:
     */
     PDBHeuristic(const plugins::Options &opts);
     virtual ~PDBHeuristic() override = default;
+
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const override;
 };
 }
 
@@ -27,6 +27,10 @@ ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
       zero_one_pdbs(get_zero_one_pdbs_from_options(task, opts)) {
 }
 
+shared_ptr<Evaluator> ZeroOnePDBsHeuristic::create_thread_copy() const {
+    return make_shared<ZeroOnePDBsHeuristic>(*this);
+}
+
 int ZeroOnePDBsHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     int h = zero_one_pdbs.get_value(state);
@@ -15,6 +15,8 @@ protected:
 public:
     ZeroOnePDBsHeuristic(const plugins::Options &opts);
     virtual ~ZeroOnePDBsHeuristic() = default;
+
+    virtual std::shared_ptr<Evaluator> create_thread_copy() const override;
 };
 }
 
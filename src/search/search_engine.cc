@@ -1,5 +1,6 @@
 #include "search_engine.h"
 
+#include "compressed_state_registry.h"
 #include "evaluation_context.h"
 #include "evaluator.h"
 
@@ -23,12 +24,16 @@ using utils::ExitCode;
 class PruningMethod;
 
 successor_generator::SuccessorGenerator &get_successor_generator(
-    const TaskProxy &task_proxy, utils::LogProxy &log) {
+    const TaskProxy &task_proxy,
+    successor_generator::SuccessorGeneratorType type,
+    utils::LogProxy &log) {
     log << "Building successor generator..." << flush;
     int peak_memory_before = utils::get_peak_memory_in_kb();
     utils::Timer successor_generator_timer;
     successor_generator::SuccessorGenerator &successor_generator =
-        successor_generator::g_successor_generators[task_proxy];
+        (type == successor_generator::SuccessorGeneratorType::COMPILED)
+        ? successor_generator::g_compiled_successor_generators[task_proxy]
+        : successor_generator::g_successor_generators[task_proxy];
     successor_generator_timer.stop();
     log << "done!" << endl;
     int peak_memory_after = utils::get_peak_memory_in_kb();
@@ -47,9 +52,18 @@ SearchEngine::SearchEngine(const plugins::Options &opts)
       task(tasks::g_root_task),
       task_proxy(*task),
       log(utils::get_log_from_options(opts)),
-      state_registry(task_proxy),
-      successor_generator(get_successor_generator(task_proxy, log)),
-      search_space(state_registry, log),
+      owned_state_registry(
+          create_state_registry(
+              task_proxy, opts.get<StateStorage>("state_storage"))),
+      state_registry(*owned_state_registry),
+      successor_generator(
+          get_successor_generator(
+              task_proxy,
+              opts.get<successor_generator::SuccessorGeneratorType>(
+                  "successor_generator"),
+              log)),
+      search_space(state_registry, opts.get<OperatorCost>("cost_type"),
+                   opts.get<bool>("parent_pointers"), log),
       statistics(log),
       cost_type(opts.get<OperatorCost>("cost_type")),
       is_unit_cost(task_properties::is_unit_cost(task_proxy)),
@@ -148,6 +162,25 @@ void SearchEngine::add_options_to_feature(plugins::Feature &feature) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    feature.add_option<successor_generator::SuccessorGeneratorType>(
+        "successor_generator",
+        "representation of the successor generator. Both representations "
+        "generate the same operators in the same order.",
+        "tree");
+    feature.add_option<bool>(
+        "parent_pointers",
+        "store the parent state of each search node. Without parent "
+        "pointers, the search needs 4 bytes less per state, but the plan "
+        "is reconstructed by a backward search over all registered states "
+        "after a goal state has been found, which looks at every registered "
+        "state once per plan step.",
+        "true");
+    feature.add_option<StateStorage>(
+        "state_storage",
+        "how registered states are stored. Compressed storage needs less "
+        "memory per state for many tasks but makes registering and looking "
+        "up states slower.",
+        "packed");
     utils::add_log_options_to_feature(feature);
 }
 
@@ -12,6 +12,7 @@
 
 #include "utils/logging.h"
 
+#include <memory>
 #include <vector>
 
 namespace plugins {
@@ -43,7 +44,8 @@ protected:
 
     mutable utils::LogProxy log;
     PlanManager plan_manager;
-    StateRegistry state_registry;
+    std::unique_ptr<StateRegistry> owned_state_registry;
+    StateRegistry &state_registry;
     const successor_generator::SuccessorGenerator &successor_generator;
     SearchSpace search_space;
     SearchProgress search_progress;
@@ -6,12 +6,15 @@
 #include "../pruning_method.h"
 
 #include "../algorithms/ordered_set.h"
-#include "../plugins/options.h"
+#include "../plugins/plugin.h"
 #include "../task_utils/successor_generator.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <optional.hh>
 #include <set>
@@ -27,19 +30,12 @@ EagerSearch::EagerSearch(const plugins::Options &opts)
       f_evaluator(opts.get<shared_ptr<Evaluator>>("f_eval", nullptr)),
       preferred_operator_evaluators(opts.get_list<shared_ptr<Evaluator>>("preferred")),
       lazy_evaluator(opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr)),
-      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")) {
+      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      num_evaluation_threads(opts.get<int>("evaluation_threads")) {
     if (lazy_evaluator && !lazy_evaluator->does_cache_estimates()) {
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
     }
-}
-
-void EagerSearch::initialize() {
-    log << "Conducting best first search"
-        << (reopen_closed_nodes ? " with" : " without")
-        << " reopening closed nodes, (real) bound = " << bound
-        << endl;
-    assert(open_list);
 
     set<Evaluator *> evals;
     open_list->get_path_dependent_evaluators(evals);
@@ -71,6 +67,40 @@ void EagerSearch::initialize() {
 
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
+    if (num_evaluation_threads > 1)
+        initialize_parallel_evaluator();
+}
+
+void EagerSearch::initialize_parallel_evaluator() {
+    if (!path_dependent_evaluators.empty()) {
+        cerr << "Parallel evaluation does not support path-dependent "
+             << "evaluators." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+    /*
+      Only the heuristics of the open list and the f-evaluator are computed
+      in parallel. Other evaluators (g, sums, weights, ...) are cheap and
+      computed by the open list from the heuristic values as usual.
+    */
+    set<Evaluator *> heuristic_set;
+    open_list->get_heuristics(heuristic_set);
+    if (f_evaluator) {
+        f_evaluator->get_heuristics(heuristic_set);
+    }
+    vector<Evaluator *> heuristics(heuristic_set.begin(), heuristic_set.end());
+    log << "Evaluating successors with " << num_evaluation_threads
+        << " threads." << endl;
+    parallel_evaluator = utils::make_unique_ptr<ParallelSuccessorEvaluator>(
+        heuristics, num_evaluation_threads, state_registry.get_initial_state());
+}
+
+void EagerSearch::initialize() {
+    log << "Conducting best first search"
+        << (reopen_closed_nodes ? " with" : " without")
+        << " reopening closed nodes, (real) bound = " << bound
+        << endl;
+    assert(open_list);
+
     State initial_state = state_registry.get_initial_state();
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
@@ -189,12 +219,61 @@ SearchStatus EagerSearch::step() {
                                     preferred_operators);
     }
 
+    vector<OperatorID> successor_ops;
+    successor_ops.reserve(applicable_ops.size());
     for (OperatorID op_id : applicable_ops) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
-        if ((node->get_real_g() + op.get_cost()) >= bound)
-            continue;
+        if ((node->get_real_g() + op.get_cost()) < bound)
+            successor_ops.push_back(op_id);
+    }
+
+    vector<State> succ_states;
+    succ_states.reserve(successor_ops.size());
+    state_registry.get_successor_states(s, successor_ops, succ_states);
+
+    /*
+      With several evaluation threads, the heuristics are computed for
+      all new successors in parallel first. The successors are then
+      processed in their original order as usual, so the search behaves
+      exactly as with sequential evaluation. (Only the number of
+      evaluations can differ: sequential evaluation stops evaluating a
+      dead end after the first heuristic that detects it.)
+    */
+    vector<SuccessorEvaluation> successor_evaluations;
+    vector<int> evaluation_indices;
+    if (parallel_evaluator) {
+        evaluation_indices.assign(successor_ops.size(), -1);
+        for (size_t i = 0; i < successor_ops.size(); ++i) {
+            const State &succ_state = succ_states[i];
+            if (!search_space.get_node(succ_state).is_new())
+                continue;
+            /*
+              If several operators lead to the same state, only its first
+              occurrence is evaluated (as in sequential evaluation).
+            */
+            auto it = find_if(
+                successor_evaluations.begin(), successor_evaluations.end(),
+                [&](const SuccessorEvaluation &evaluation) {
+                    return evaluation.state.get_id() == succ_state.get_id();
+                });
+            if (it != successor_evaluations.end()) {
+                evaluation_indices[i] = it - successor_evaluations.begin();
+                continue;
+            }
+            OperatorProxy op = task_proxy.get_operators()[successor_ops[i]];
+            evaluation_indices[i] = successor_evaluations.size();
+            successor_evaluations.emplace_back(
+                succ_state, node->get_g() + get_adjusted_cost(op),
+                preferred_operators.contains(successor_ops[i]),
+                get_upper_bound_hint(*node, op));
+        }
+        parallel_evaluator->evaluate(successor_evaluations);
+    }
 
-        State succ_state = state_registry.get_successor_state(s, op);
+    for (size_t i = 0; i < successor_ops.size(); ++i) {
+        OperatorID op_id = successor_ops[i];
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        const State &succ_state = succ_states[i];
         statistics.inc_generated();
         bool is_preferred = preferred_operators.contains(op_id);
 
@@ -217,8 +296,19 @@ SearchStatus EagerSearch::step() {
             // TODO: Make this less fragile.
             int succ_g = node->get_g() + get_adjusted_cost(op);
 
+            EvaluatorCache precomputed_results;
+            if (parallel_evaluator) {
+                assert(evaluation_indices[i] != -1);
+                SuccessorEvaluation &evaluation =
+                    successor_evaluations[evaluation_indices[i]];
+                precomputed_results = move(evaluation.results);
+                statistics.inc_evaluations(evaluation.num_evaluations);
+            }
             EvaluationContext succ_eval_context(
-                succ_state, succ_g, is_preferred, &statistics);
+                precomputed_results, succ_state, succ_g, is_preferred,
+                &statistics);
+            succ_eval_context.set_upper_bound_hint(
+                get_upper_bound_hint(*node, op));
             statistics.inc_evaluated_states();
 
             if (open_list->is_dead_end(succ_eval_context)) {
@@ -250,6 +340,8 @@ SearchStatus EagerSearch::step() {
 
                 EvaluationContext succ_eval_context(
                     succ_state, succ_node.get_g(), is_preferred, &statistics);
+                succ_eval_context.set_upper_bound_hint(
+                    get_upper_bound_hint(*node, op));
 
                 /*
                   Note: our old code used to retrieve the h value from
@@ -281,6 +373,21 @@ SearchStatus EagerSearch::step() {
     return IN_PROGRESS;
 }
 
+int EagerSearch::get_upper_bound_hint(
+    const SearchNode &node, const OperatorProxy &op) const {
+    /*
+      A* cannot find a plan below the cost bound through a successor
+      whose f-value reaches the bound, so the evaluators do not need to
+      compute exact heuristic values beyond this point. We only use the
+      hint if the heuristic values and the bound refer to the same costs.
+    */
+    if (!f_evaluator || bound == numeric_limits<int>::max() ||
+        cost_type != OperatorCost::NORMAL) {
+        return EvaluationResult::INFTY;
+    }
+    return bound - (node.get_real_g() + op.get_cost()) - 1;
+}
+
 void EagerSearch::reward_progress() {
     // Boost the "preferred operator" open lists somewhat whenever
     // one of the heuristics finds a state with a new best h value.
@@ -308,6 +415,22 @@ void EagerSearch::update_f_value_statistics(EvaluationContext &eval_context) {
 }
 
 void add_options_to_feature(plugins::Feature &feature) {
+    feature.add_option<int>(
+        "evaluation_threads",
+        "number of threads used to evaluate the new successors of an "
+        "expanded state. With more than one thread, each additional thread "
+        "uses copies of the heuristics that share their precomputed data "
+        "(e.g., pattern databases). Only the heuristics blind, goalcount, "
+        "hmax, add, ff, lmcut, pdb, cpdbs, ipdb, zopdbs, merge_and_shrink "
+        "and cegar support this, also within sum, max and weight. "
+        "Successors are inserted into the open list in the same order as "
+        "with sequential evaluation. Note that on Linux each thread "
+        "reserves address space for its own allocation arena, which can "
+        "increase the reported peak memory (and the memory counted "
+        "towards the memory limit) by more than 100 MB. Setting the "
+        "environment variable MALLOC_ARENA_MAX=1 avoids this.",
+        "1",
+        plugins::Bounds("1", "infinity"));
     SearchEngine::add_pruning_option(feature);
     SearchEngine::add_options_to_feature(feature);
 }
@@ -1,6 +1,8 @@
 #ifndef SEARCH_ENGINES_EAGER_SEARCH_H
 #define SEARCH_ENGINES_EAGER_SEARCH_H
 
+#include "parallel_successor_evaluator.h"
+
 #include "../open_list.h"
 #include "../search_engine.h"
 
@@ -27,9 +29,15 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    const int num_evaluation_threads;
+    std::unique_ptr<ParallelSuccessorEvaluator> parallel_evaluator;
+
+    void initialize_parallel_evaluator();
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(EvaluationContext &eval_context);
     void reward_progress();
+    int get_upper_bound_hint(const SearchNode &node,
+                             const OperatorProxy &op) const;
 
 protected:
     virtual void initialize() override;
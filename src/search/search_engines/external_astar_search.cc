@@ -0,0 +1,457 @@
+#include "external_astar_search.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+
+#include "../plugins/plugin.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/logging.h"
+#include "../utils/markup.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <queue>
+#include <set>
+
+using namespace std;
+
+namespace external_astar_search {
+// Number of states after which we replace the temporary state registry.
+static const int SCRATCH_REGISTRY_SIZE = 100000;
+
+static int compare_states(
+    const PackedStateBin *state1, const PackedStateBin *state2, int num_bins) {
+    for (int i = 0; i < num_bins; ++i) {
+        if (state1[i] != state2[i])
+            return state1[i] < state2[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+static void check_stream(const ios &stream, const filesystem::path &path) {
+    if (!stream) {
+        cerr << "Error accessing " << path << " for external search." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+
+/*
+  Sequential access to sorted records, either from a file or from a
+  vector in memory.
+*/
+class RecordReader {
+    const int record_size;
+    ifstream file;
+    vector<PackedStateBin> records;
+    size_t next_pos;
+    vector<PackedStateBin> current;
+    bool valid;
+public:
+    RecordReader(const filesystem::path &path, int record_size)
+        : record_size(record_size),
+          file(path, ios::binary),
+          next_pos(0),
+          current(record_size),
+          valid(false) {
+        check_stream(file, path);
+        advance();
+    }
+
+    RecordReader(vector<PackedStateBin> &&records, int record_size)
+        : record_size(record_size),
+          records(move(records)),
+          next_pos(0),
+          current(record_size),
+          valid(false) {
+        advance();
+    }
+
+    bool has_record() const {
+        return valid;
+    }
+
+    const PackedStateBin *get() const {
+        assert(valid);
+        return current.data();
+    }
+
+    void advance() {
+        if (file.is_open()) {
+            file.read(reinterpret_cast<char *>(current.data()),
+                      record_size * sizeof(PackedStateBin));
+            valid = static_cast<bool>(file);
+        } else {
+            valid = next_pos < records.size();
+            if (valid) {
+                copy(records.begin() + next_pos,
+                     records.begin() + next_pos + record_size,
+                     current.begin());
+                next_pos += record_size;
+            }
+        }
+    }
+};
+
+
+ExternalAStarSearch::ExternalAStarSearch(const plugins::Options &opts)
+    : SearchEngine(opts),
+      evaluator(opts.get<shared_ptr<Evaluator>>("eval")),
+      num_bins(state_registry.get_num_bins()),
+      record_size(num_bins + 1),
+      max_buffered_records(
+          static_cast<size_t>(opts.get<int>("buffer_size")) * 1024 * 1024 /
+          ((num_bins + 1) * sizeof(PackedStateBin))),
+      num_buffered_records(0),
+      num_files(0),
+      scratch_registry(utils::make_unique_ptr<StateRegistry>(task_proxy)),
+      record(num_bins + 1),
+      last_f(-1) {
+    if (cost_type != OperatorCost::NORMAL) {
+        cerr << "External A* only supports cost_type=normal." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+    set<Evaluator *> path_dependent_evaluators;
+    evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+    if (!path_dependent_evaluators.empty()) {
+        cerr << "External A* does not support path-dependent evaluators."
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+}
+
+ExternalAStarSearch::~ExternalAStarSearch() {
+    if (!directory.empty()) {
+        error_code error;
+        filesystem::remove_all(directory, error);
+    }
+}
+
+filesystem::path ExternalAStarSearch::get_new_file_path() {
+    return directory / (to_string(num_files++) + ".records");
+}
+
+State ExternalAStarSearch::register_state(const PackedStateBin *buffer) {
+    if (scratch_registry->size() >= SCRATCH_REGISTRY_SIZE) {
+        scratch_registry = utils::make_unique_ptr<StateRegistry>(task_proxy);
+    }
+    return scratch_registry->insert_state(buffer);
+}
+
+void ExternalAStarSearch::add_record(
+    int g, int h, const PackedStateBin *buffer, OperatorID op_id) {
+    Bucket &bucket = buckets.try_emplace(make_pair(g + h, h), g, h)
+        .first->second;
+    bucket.buffer.insert(bucket.buffer.end(), buffer, buffer + num_bins);
+    bucket.buffer.push_back(static_cast<PackedStateBin>(op_id.get_index()));
+    if (++num_buffered_records >= max_buffered_records) {
+        write_all_runs();
+    }
+}
+
+static vector<PackedStateBin> sort_records(
+    const vector<PackedStateBin> &records, int record_size) {
+    int num_records = records.size() / record_size;
+    int num_bins = record_size - 1;
+    vector<int> order(num_records);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(),
+         [&](int i, int j) {
+             return compare_states(&records[i * record_size],
+                                   &records[j * record_size], num_bins) < 0;
+         });
+    vector<PackedStateBin> sorted_records;
+    sorted_records.reserve(records.size());
+    for (int i : order) {
+        auto begin = records.begin() + i * record_size;
+        sorted_records.insert(sorted_records.end(), begin, begin + record_size);
+    }
+    return sorted_records;
+}
+
+void ExternalAStarSearch::write_run(Bucket &bucket) {
+    if (bucket.buffer.empty())
+        return;
+    filesystem::path path = get_new_file_path();
+    vector<PackedStateBin> sorted_records =
+        sort_records(bucket.buffer, record_size);
+    ofstream file(path, ios::binary);
+    file.write(reinterpret_cast<const char *>(sorted_records.data()),
+               sorted_records.size() * sizeof(PackedStateBin));
+    check_stream(file, path);
+    num_buffered_records -= bucket.buffer.size() / record_size;
+    // Free the memory of the buffer.
+    vector<PackedStateBin>().swap(bucket.buffer);
+    bucket.runs.push_back(path);
+}
+
+void ExternalAStarSearch::write_all_runs() {
+    for (auto &entry : buckets) {
+        write_run(entry.second);
+    }
+}
+
+void ExternalAStarSearch::expand(const PackedStateBin *state_record, int g) {
+    State state = register_state(state_record);
+    statistics.inc_expanded();
+
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(state, applicable_ops);
+    statistics.inc_generated_ops(applicable_ops.size());
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = operators[op_id];
+        int succ_g = g + get_adjusted_cost(op);
+        if (succ_g >= bound)
+            continue;
+
+        State succ_state = scratch_registry->get_successor_state(state, op);
+        statistics.inc_generated();
+        EvaluationContext eval_context(succ_state, succ_g, false, &statistics);
+        statistics.inc_evaluated_states();
+        if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+            statistics.inc_dead_ends();
+            continue;
+        }
+        int h = eval_context.get_evaluator_value(evaluator.get());
+        add_record(succ_g, h, succ_state.get_buffer(), op_id);
+    }
+}
+
+void ExternalAStarSearch::initialize() {
+    log << "Conducting external A* search, (real) bound = " << bound << endl;
+
+    directory = filesystem::temp_directory_path() /
+        ("downward-external-astar-" + to_string(utils::get_process_id()));
+    try {
+        filesystem::remove_all(directory);
+        filesystem::create_directories(directory);
+    } catch (const filesystem::filesystem_error &error) {
+        cerr << "Could not create directory for external search: "
+             << error.what() << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    log << "Storing states in " << directory << endl;
+
+    const State &initial_state = state_registry.get_initial_state();
+    EvaluationContext eval_context(initial_state, 0, true, &statistics);
+    statistics.inc_evaluated_states();
+    print_initial_evaluator_values(eval_context);
+    if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+        log << "Initial state is a dead end." << endl;
+    } else {
+        add_record(0, eval_context.get_evaluator_value(evaluator.get()),
+                   initial_state.get_buffer(), OperatorID::no_operator);
+    }
+}
+
+SearchStatus ExternalAStarSearch::step() {
+    if (buckets.empty()) {
+        log << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+
+    auto bucket_it = buckets.begin();
+    int f = bucket_it->first.first;
+    Bucket bucket = move(bucket_it->second);
+    buckets.erase(bucket_it);
+    if (f > last_f) {
+        statistics.report_f_value_progress(f);
+        last_f = f;
+    }
+
+    // Merge the sorted runs and the sorted buffer of the bucket.
+    vector<unique_ptr<RecordReader>> readers;
+    for (const filesystem::path &path : bucket.runs) {
+        readers.push_back(utils::make_unique_ptr<RecordReader>(path, record_size));
+    }
+    num_buffered_records -= bucket.buffer.size() / record_size;
+    readers.push_back(utils::make_unique_ptr<RecordReader>(
+                          sort_records(bucket.buffer, record_size), record_size));
+    vector<PackedStateBin>().swap(bucket.buffer);
+
+    auto compare = [&](int i, int j) {
+            return compare_states(
+                readers[i]->get(), readers[j]->get(), num_bins) > 0;
+        };
+    priority_queue<int, vector<int>, decltype(compare)> queue(compare);
+    for (size_t i = 0; i < readers.size(); ++i) {
+        if (readers[i]->has_record())
+            queue.push(i);
+    }
+
+    /*
+      States expanded before with the same h value and at most the same g
+      value are duplicates.
+    */
+    vector<unique_ptr<RecordReader>> closed_readers;
+    for (const ExpandedFile &file : expanded_files) {
+        if (file.h == bucket.h && file.g <= bucket.g) {
+            closed_readers.push_back(
+                utils::make_unique_ptr<RecordReader>(file.path, record_size));
+        }
+    }
+
+    filesystem::path expanded_path = get_new_file_path();
+    int expanded_file_index = expanded_files.size();
+    ofstream expanded_file(expanded_path, ios::binary);
+    check_stream(expanded_file, expanded_path);
+    vector<PackedStateBin> previous_state;
+    while (!queue.empty()) {
+        int reader_index = queue.top();
+        queue.pop();
+        RecordReader &reader = *readers[reader_index];
+        const PackedStateBin *current = reader.get();
+
+        bool is_duplicate = !previous_state.empty() &&
+            compare_states(current, previous_state.data(), num_bins) == 0;
+        if (!is_duplicate) {
+            previous_state.assign(current, current + num_bins);
+            for (const unique_ptr<RecordReader> &closed : closed_readers) {
+                while (closed->has_record() &&
+                       compare_states(closed->get(), current, num_bins) < 0) {
+                    closed->advance();
+                }
+                if (closed->has_record() &&
+                    compare_states(closed->get(), current, num_bins) == 0) {
+                    is_duplicate = true;
+                    break;
+                }
+            }
+        }
+        if (!is_duplicate) {
+            copy(current, current + record_size, record.begin());
+            expanded_file.write(reinterpret_cast<const char *>(record.data()),
+                                record_size * sizeof(PackedStateBin));
+            State state = register_state(record.data());
+            if (task_properties::is_goal_state(task_proxy, state)) {
+                expanded_file.close();
+                check_stream(expanded_file, expanded_path);
+                expanded_files.emplace_back(bucket.g, bucket.h, expanded_path);
+                log << "Solution found!" << endl;
+                set_plan(reconstruct_plan(
+                             record, bucket.g, expanded_file_index));
+                return SOLVED;
+            }
+            expand(record.data(), bucket.g);
+        }
+
+        reader.advance();
+        if (reader.has_record())
+            queue.push(reader_index);
+    }
+    expanded_file.close();
+    check_stream(expanded_file, expanded_path);
+    expanded_files.emplace_back(bucket.g, bucket.h, expanded_path);
+
+    readers.clear();
+    for (const filesystem::path &path : bucket.runs) {
+        filesystem::remove(path);
+    }
+    return IN_PROGRESS;
+}
+
+Plan ExternalAStarSearch::reconstruct_plan(
+    vector<PackedStateBin> goal_record, int goal_g, int goal_file_index) {
+    Plan plan;
+    vector<PackedStateBin> current = move(goal_record);
+    int g = goal_g;
+    int file_index = goal_file_index;
+    vector<PackedStateBin> successor_buffer(num_bins);
+    OperatorsProxy operators = task_proxy.get_operators();
+    while (true) {
+        OperatorID op_id(static_cast<int>(current[num_bins]));
+        if (op_id == OperatorID::no_operator)
+            break;
+        OperatorProxy op = operators[op_id];
+        int predecessor_g = g - get_adjusted_cost(op);
+
+        /*
+          The predecessor was expanded before the state was generated,
+          so it is in an earlier file.
+        */
+        bool found = false;
+        for (int i = file_index - 1; i >= 0 && !found; --i) {
+            if (expanded_files[i].g != predecessor_g)
+                continue;
+            RecordReader reader(expanded_files[i].path, record_size);
+            for (; reader.has_record(); reader.advance()) {
+                State predecessor = register_state(reader.get());
+                if (!task_properties::is_applicable(op, predecessor))
+                    continue;
+                scratch_registry->compute_successor_buffer(
+                    predecessor, op, successor_buffer.data());
+                if (compare_states(successor_buffer.data(), current.data(),
+                                   num_bins) == 0) {
+                    current.assign(reader.get(), reader.get() + record_size);
+                    g = predecessor_g;
+                    file_index = i;
+                    found = true;
+                    break;
+                }
+            }
+        }
+        if (!found) {
+            ABORT("Predecessor not found in external search files.");
+        }
+        plan.push_back(op_id);
+    }
+    reverse(plan.begin(), plan.end());
+    return plan;
+}
+
+void ExternalAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    log << "Files written: " << num_files << endl;
+}
+
+class ExternalAStarSearchFeature : public plugins::TypedFeature<SearchEngine, ExternalAStarSearch> {
+public:
+    ExternalAStarSearchFeature() : TypedFeature("external_astar") {
+        document_title("External A* search");
+        document_synopsis(
+            "A* search with delayed duplicate detection that stores states "
+            "in files instead of a state registry, so that the search is not "
+            "limited by the available memory. States are kept in sorted "
+            "files per pair of g and h values, and duplicates are removed by "
+            "merging these files. For details, see" +
+            utils::format_conference_reference(
+                {"Stefan Edelkamp", "Shahid Jabbar", "Stefan Schroedl"},
+                "External A*",
+                "https://doi.org/10.1007/978-3-540-30221-6_18",
+                "Proceedings of the 27th Annual German Conference on "
+                "Artificial Intelligence (KI 2004)",
+                "226-240",
+                "Springer-Verlag",
+                "2004"));
+
+        add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+        add_option<int>(
+            "buffer_size",
+            "maximal memory in MiB used for buffering generated states before "
+            "they are written to disk",
+            "256",
+            plugins::Bounds("1", "infinity"));
+        SearchEngine::add_options_to_feature(*this);
+
+        document_note(
+            "Files",
+            "The files are stored in a subdirectory of the directory for "
+            "temporary files, i.e., the directory given by the environment "
+            "variable TMPDIR on Unix systems (/tmp if it is not set). Set it "
+            "to a directory on a fast local disk. The files are removed when "
+            "the search ends.");
+        document_note(
+            "Optimality",
+            "Plans are optimal if the evaluator is admissible. A state is "
+            "expanded again if an inconsistent evaluator leads to a cheaper "
+            "path to it later. "
+            "Only cost_type=normal is supported.");
+    }
+};
+
+static plugins::FeaturePlugin<ExternalAStarSearchFeature> _plugin;
+}
@@ -0,0 +1,113 @@
+#ifndef SEARCH_ENGINES_EXTERNAL_ASTAR_SEARCH_H
+#define SEARCH_ENGINES_EXTERNAL_ASTAR_SEARCH_H
+
+#include "../search_engine.h"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Evaluator;
+
+/*
+  External A* (Edelkamp, Jabbar and Schroedl, KI 2004): A* with delayed
+  duplicate detection that keeps the states on disk instead of in a
+  state registry.
+
+  A record consists of the packed data of a state (in the format of the
+  state registry) followed by the ID of the operator that generated it.
+  Generated states are collected in buckets by their g and h values.
+  A bucket stores its records in an in-memory buffer, which is sorted
+  and written to disk as a "run" file when the buffers of all buckets
+  together exceed the given size.
+
+  The buckets are expanded in order of increasing f and, for equal f,
+  increasing h. Expanding a bucket merges its sorted runs and removes
+  duplicates, as well as all states contained in previously expanded
+  buckets with the same h value and at most the same g value (a state
+  always has the same h value, so it cannot occur in buckets with other
+  h values). The remaining
+  states are written to the sorted file of expanded states of the
+  bucket while they are expanded. Successors are only ever added to the
+  buffers of buckets, never to the files currently being read, so each
+  expansion of a bucket is a sequential pass over its files.
+
+  Plans are reconstructed backwards from the goal state: the generating
+  operator of a state is stored in its record, and its predecessor is
+  found by scanning the expanded files with the right g value that were
+  written before the file of the state.
+*/
+namespace external_astar_search {
+struct ExpandedFile {
+    int g;
+    int h;
+    std::filesystem::path path;
+
+    ExpandedFile(int g, int h, const std::filesystem::path &path)
+        : g(g), h(h), path(path) {
+    }
+};
+
+struct Bucket {
+    int g;
+    int h;
+    // Unsorted records not yet written to disk.
+    std::vector<PackedStateBin> buffer;
+    // Files with sorted records.
+    std::vector<std::filesystem::path> runs;
+
+    Bucket(int g, int h)
+        : g(g), h(h) {
+    }
+};
+
+class ExternalAStarSearch : public SearchEngine {
+    std::shared_ptr<Evaluator> evaluator;
+    const int num_bins;
+    // Bins of a record: the packed state followed by the operator ID.
+    const int record_size;
+    const size_t max_buffered_records;
+    size_t num_buffered_records;
+    std::filesystem::path directory;
+    int num_files;
+
+    // Buckets with records that are not yet expanded, keyed by (f, h).
+    std::map<std::pair<int, int>, Bucket> buckets;
+    // Files of expanded states in the order in which they were written.
+    std::vector<ExpandedFile> expanded_files;
+    /*
+      Evaluating and expanding states requires registered states, so we
+      register them in a temporary registry that we replace regularly.
+      This frees all information the evaluators cached for its states.
+    */
+    std::unique_ptr<StateRegistry> scratch_registry;
+    std::vector<PackedStateBin> record;
+    int last_f;
+
+    std::filesystem::path get_new_file_path();
+    State register_state(const PackedStateBin *buffer);
+    void add_record(int g, int h, const PackedStateBin *buffer,
+                    OperatorID op_id);
+    void write_run(Bucket &bucket);
+    void write_all_runs();
+    void expand(const PackedStateBin *state_record, int g);
+    Plan reconstruct_plan(std::vector<PackedStateBin> goal_record,
+                          int goal_g, int goal_file_index);
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit ExternalAStarSearch(const plugins::Options &opts);
+    virtual ~ExternalAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
@@ -0,0 +1,489 @@
+#include "hda_star_search.h"
+
+#include "search_common.h"
+
+#include "../concurrent_state_registry.h"
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../open_list_factory.h"
+
+#include "../plugins/plugin.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/logging.h"
+#include "../utils/markup.h"
+#include "../utils/memory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace hda_star_search {
+// Shards of the shared registry. More shards make lock conflicts rarer.
+static const int SHARDS_PER_THREAD = 16;
+
+void MessageQueue::push(const vector<PackedStateBin> &new_buffers,
+                        const vector<SuccessorMessage> &new_messages) {
+    lock_guard<mutex> lock(access_mutex);
+    buffers.insert(buffers.end(), new_buffers.begin(), new_buffers.end());
+    messages.insert(messages.end(), new_messages.begin(), new_messages.end());
+}
+
+void MessageQueue::pop_all(vector<PackedStateBin> &out_buffers,
+                           vector<SuccessorMessage> &out_messages) {
+    assert(out_buffers.empty() && out_messages.empty());
+    lock_guard<mutex> lock(access_mutex);
+    buffers.swap(out_buffers);
+    messages.swap(out_messages);
+}
+
+
+HDAStarWorker::HDAStarWorker(
+    HDAStarSearch &engine, int id, const shared_ptr<Evaluator> &eval,
+    utils::Verbosity verbosity)
+    : engine(engine),
+      id(id),
+      num_bins(engine.state_registry.get_num_bins()),
+      own_registry(engine.shared_registry ? nullptr :
+                   utils::make_unique_ptr<StateRegistry>(engine.task_proxy)),
+      state_registry(engine.shared_registry ?
+                     *engine.shared_registry : *own_registry),
+      log(utils::get_silent_log()),
+      statistics(log),
+      outgoing_buffers(engine.num_threads),
+      outgoing_messages(engine.num_threads),
+      successor_buffer(num_bins),
+      active(true),
+      best_goal_id(StateID::no_state) {
+    plugins::Options opts;
+    opts.set("eval", eval);
+    opts.set<utils::Verbosity>("verbosity", verbosity);
+    opts.set<search_common::AStarOpenList>("open_list", engine.open_list_type);
+    opts.set<OperatorCost>("cost_type", engine.cost_type);
+    auto open_list_factory_and_f_eval =
+        search_common::create_astar_open_list_factory_and_f_eval(opts);
+    open_list = open_list_factory_and_f_eval.first->create_state_open_list();
+    f_evaluator = open_list_factory_and_f_eval.second;
+
+    set<Evaluator *> path_dependent_evaluators;
+    open_list->get_path_dependent_evaluators(path_dependent_evaluators);
+    if (!path_dependent_evaluators.empty()) {
+        cerr << "HDA* does not support path-dependent evaluators." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+}
+
+const HDAStarNodeInfo &HDAStarWorker::get_node_info(StateID id) const {
+    return search_node_infos[state_registry.lookup_state(id)];
+}
+
+void HDAStarWorker::insert_initial_state(const PackedStateBin *buffer) {
+    State initial_state = state_registry.insert_state(buffer);
+    EvaluationContext eval_context(initial_state, 0, true, &statistics);
+    statistics.inc_evaluated_states();
+    if (open_list->is_dead_end(eval_context)) {
+        engine.log << "Initial state is a dead end." << endl;
+    } else {
+        HDAStarNodeInfo &info = search_node_infos[initial_state];
+        info.status = HDAStarNodeInfo::OPEN;
+        info.g = 0;
+        info.real_g = 0;
+        open_list->insert(eval_context, initial_state.get_id());
+    }
+    print_initial_evaluator_values(eval_context);
+}
+
+void HDAStarWorker::receive_successor(
+    const State &succ_state, const SuccessorMessage &message) {
+    HDAStarNodeInfo &info = search_node_infos[succ_state];
+
+    // Previously encountered dead end. Don't re-evaluate.
+    if (info.status == HDAStarNodeInfo::DEAD_END)
+        return;
+
+    if (info.status == HDAStarNodeInfo::NEW) {
+        EvaluationContext eval_context(
+            succ_state, message.g, false, &statistics);
+        statistics.inc_evaluated_states();
+        if (open_list->is_dead_end(eval_context)) {
+            info.status = HDAStarNodeInfo::DEAD_END;
+            statistics.inc_dead_ends();
+            return;
+        }
+        info.status = HDAStarNodeInfo::OPEN;
+        info.g = message.g;
+        info.real_g = message.real_g;
+        info.parent_worker = message.parent_worker;
+        info.parent_state_id = message.parent_state_id;
+        info.creating_operator = message.creating_operator;
+        open_list->insert(eval_context, succ_state.get_id());
+    } else if (info.g > message.g) {
+        /*
+          In contrast to sequential A*, nodes are not expanded in global
+          f order, so we can find cheaper paths to closed nodes even with
+          consistent heuristics and have to reopen them to stay optimal.
+        */
+        if (info.status == HDAStarNodeInfo::CLOSED) {
+            statistics.inc_reopened();
+        }
+        info.status = HDAStarNodeInfo::OPEN;
+        info.g = message.g;
+        info.real_g = message.real_g;
+        info.parent_worker = message.parent_worker;
+        info.parent_state_id = message.parent_state_id;
+        info.creating_operator = message.creating_operator;
+        EvaluationContext eval_context(
+            succ_state, message.g, false, &statistics);
+        open_list->insert(eval_context, succ_state.get_id());
+    }
+}
+
+bool HDAStarWorker::process_inbox() {
+    assert(received_buffers.empty() && received_messages.empty());
+    inbox.pop_all(received_buffers, received_messages);
+    int num_messages = received_messages.size();
+    if (num_messages == 0) {
+        return false;
+    }
+    if (!active) {
+        // Become active before the messages stop counting as pending work.
+        active = true;
+        ++engine.num_pending_work_items;
+    }
+    for (int i = 0; i < num_messages; ++i) {
+        const SuccessorMessage &message = received_messages[i];
+        if (engine.shared_registry) {
+            receive_successor(
+                state_registry.lookup_state(message.state_id), message);
+        } else {
+            receive_successor(
+                state_registry.insert_state(&received_buffers[i * num_bins]),
+                message);
+        }
+    }
+    received_buffers.clear();
+    received_messages.clear();
+    engine.num_pending_work_items -= num_messages;
+    return true;
+}
+
+bool HDAStarWorker::expand_next_node() {
+    OperatorsProxy operators = engine.task_proxy.get_operators();
+    while (!open_list->empty()) {
+        StateID state_id = open_list->remove_min();
+        State state = state_registry.lookup_state(state_id);
+        HDAStarNodeInfo &info = search_node_infos[state];
+        if (info.status != HDAStarNodeInfo::OPEN)
+            continue;
+
+        EvaluationContext eval_context(state, info.g, false, &statistics);
+        int f = eval_context.get_evaluator_value_or_infinity(f_evaluator.get());
+        /*
+          The incumbent cost never increases, so nodes that cannot lead
+          to a cheaper solution can be discarded for good.
+        */
+        if (f >= engine.incumbent_cost)
+            continue;
+
+        info.status = HDAStarNodeInfo::CLOSED;
+        statistics.inc_expanded();
+
+        if (task_properties::is_goal_state(engine.task_proxy, state)) {
+            if (engine.report_solution(id, info.g)) {
+                best_goal_id = state_id;
+            }
+            return true;
+        }
+
+        vector<OperatorID> applicable_ops;
+        engine.successor_generator.generate_applicable_ops(
+            state, applicable_ops);
+        statistics.inc_generated_ops(applicable_ops.size());
+        for (OperatorID op_id : applicable_ops) {
+            OperatorProxy op = operators[op_id];
+            if (info.real_g + op.get_cost() >= engine.bound)
+                continue;
+
+            state_registry.compute_successor_buffer(
+                state, op, successor_buffer.data());
+            statistics.inc_generated();
+            SuccessorMessage message(
+                info.g + engine.get_adjusted_cost(op),
+                info.real_g + op.get_cost(), id, state_id, op_id);
+            int owner = engine.get_owner(successor_buffer.data());
+            if (owner == id) {
+                receive_successor(
+                    state_registry.insert_state(successor_buffer.data()),
+                    message);
+            } else if (engine.shared_registry) {
+                // Register the successor concurrently and only send its ID.
+                message.state_id =
+                    state_registry.insert_state(successor_buffer.data()).get_id();
+                outgoing_messages[owner].push_back(message);
+            } else {
+                outgoing_buffers[owner].insert(
+                    outgoing_buffers[owner].end(),
+                    successor_buffer.begin(), successor_buffer.end());
+                outgoing_messages[owner].push_back(message);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+void HDAStarWorker::send_outgoing_messages() {
+    for (int receiver = 0; receiver < engine.num_threads; ++receiver) {
+        vector<SuccessorMessage> &messages = outgoing_messages[receiver];
+        if (messages.empty())
+            continue;
+        // Count the messages as pending before the receiver can see them.
+        engine.num_pending_work_items += messages.size();
+        engine.workers[receiver]->get_inbox().push(
+            outgoing_buffers[receiver], messages);
+        outgoing_buffers[receiver].clear();
+        messages.clear();
+    }
+}
+
+void HDAStarWorker::run() {
+    while (true) {
+        if (engine.timed_out)
+            break;
+        if (engine.timer->is_expired()) {
+            engine.timed_out = true;
+            break;
+        }
+        process_inbox();
+        if (expand_next_node()) {
+            send_outgoing_messages();
+            continue;
+        }
+        if (active) {
+            active = false;
+            --engine.num_pending_work_items;
+        }
+        if (engine.num_pending_work_items == 0)
+            break;
+        this_thread::yield();
+    }
+}
+
+
+HDAStarSearch::HDAStarSearch(const plugins::Options &opts)
+    : SearchEngine(opts),
+      num_threads(opts.get<int>("threads")),
+      verbosity(opts.get<utils::Verbosity>("verbosity")),
+      open_list_type(opts.get<search_common::AStarOpenList>("open_list")),
+      eval_config(opts.get<parser::LazyValue>("eval")),
+      use_shared_registry(opts.get<bool>("shared_registry")),
+      incumbent_cost(numeric_limits<int>::max()),
+      incumbent_worker(-1),
+      num_pending_work_items(0),
+      timed_out(false) {
+    /*
+      All registries of a task share its axiom evaluator, which is not
+      thread-safe.
+    */
+    task_properties::verify_no_axioms(task_proxy);
+}
+
+HDAStarSearch::~HDAStarSearch() {
+}
+
+int HDAStarSearch::get_owner(const PackedStateBin *buffer) const {
+    /*
+      The registries use the low bits of the hash to find buckets, so we
+      use the high bits to assign states to workers.
+    */
+    uint64_t hash = StateRegistry::get_packed_state_hash(
+        buffer, state_registry.get_num_bins());
+    return static_cast<int>((hash * num_threads) >> 32);
+}
+
+bool HDAStarSearch::report_solution(int worker, int cost) {
+    lock_guard<mutex> lock(incumbent_mutex);
+    if (cost < incumbent_cost) {
+        incumbent_cost = cost;
+        incumbent_worker = worker;
+        log << "Solution with cost " << cost << " found by worker "
+            << worker << "." << endl;
+        return true;
+    }
+    return false;
+}
+
+void HDAStarSearch::initialize() {
+    log << "Conducting hash-distributed A* search with " << num_threads
+        << " threads, (real) bound = " << bound << endl;
+
+    if (use_shared_registry) {
+        shared_registry = utils::make_unique_ptr<ConcurrentStateRegistry>(
+            task_proxy, SHARDS_PER_THREAD * num_threads);
+    }
+
+    for (int i = 0; i < num_threads; ++i) {
+        shared_ptr<Evaluator> eval;
+        try {
+            eval = eval_config.construct<shared_ptr<Evaluator>>();
+        } catch (const utils::ContextError &e) {
+            cerr << "Delayed construction of LazyValue failed" << endl;
+            cerr << e.get_message() << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+        }
+        workers.push_back(
+            utils::make_unique_ptr<HDAStarWorker>(*this, i, eval, verbosity));
+    }
+
+    const State &initial_state = state_registry.get_initial_state();
+    const PackedStateBin *buffer = initial_state.get_buffer();
+    workers[get_owner(buffer)]->insert_initial_state(buffer);
+}
+
+SearchStatus HDAStarSearch::step() {
+    timer = utils::make_unique_ptr<utils::CountdownTimer>(max_time);
+    num_pending_work_items = num_threads;
+    vector<thread> threads;
+    threads.reserve(num_threads);
+    for (const unique_ptr<HDAStarWorker> &worker : workers) {
+        threads.emplace_back(&HDAStarWorker::run, worker.get());
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+    collect_statistics();
+
+    if (timed_out) {
+        return TIMEOUT;
+    }
+    if (incumbent_worker == -1) {
+        log << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    log << "Solution found!" << endl;
+    extract_plan();
+    return SOLVED;
+}
+
+void HDAStarSearch::extract_plan() {
+    Plan plan;
+    int worker = incumbent_worker;
+    StateID state_id = workers[worker]->get_best_goal_id();
+    assert(state_id != StateID::no_state);
+    for (;;) {
+        const HDAStarNodeInfo &info = workers[worker]->get_node_info(state_id);
+        if (info.creating_operator == OperatorID::no_operator) {
+            assert(info.parent_state_id == StateID::no_state);
+            break;
+        }
+        plan.push_back(info.creating_operator);
+        worker = info.parent_worker;
+        state_id = info.parent_state_id;
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+void HDAStarSearch::collect_statistics() {
+    for (const unique_ptr<HDAStarWorker> &worker : workers) {
+        const SearchStatistics &worker_statistics = worker->get_statistics();
+        statistics.inc_expanded(worker_statistics.get_expanded());
+        statistics.inc_evaluated_states(worker_statistics.get_evaluated_states());
+        statistics.inc_evaluations(worker_statistics.get_evaluations());
+        statistics.inc_generated(worker_statistics.get_generated());
+        statistics.inc_reopened(worker_statistics.get_reopened());
+        statistics.inc_dead_ends(worker_statistics.get_dead_ends());
+        statistics.inc_generated_ops(worker_statistics.get_generated_ops());
+    }
+}
+
+void HDAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    for (int i = 0; i < num_threads; ++i) {
+        log << "Worker " << i << ": "
+            << workers[i]->get_statistics().get_expanded() << " expanded";
+        if (!shared_registry) {
+            log << ", " << workers[i]->get_state_registry().size()
+                << " registered states";
+        }
+        log << endl;
+    }
+    if (shared_registry) {
+        shared_registry->print_statistics(log);
+    }
+}
+
+class HDAStarSearchFeature : public plugins::TypedFeature<SearchEngine, HDAStarSearch> {
+public:
+    HDAStarSearchFeature() : TypedFeature("hdastar") {
+        document_title("Hash-distributed A* search");
+        document_synopsis(
+            "Parallel A* search that assigns each state to one of several "
+            "worker threads based on the hash of the state. Each worker "
+            "uses its own state registry, open list ordered by <g + h, h> "
+            "and evaluator instances, and workers exchange generated "
+            "successors asynchronously. Closed nodes are re-opened. "
+            "For details, see" + utils::format_conference_reference(
+                {"Akihiro Kishimoto", "Alex Fukunaga", "Adi Botea"},
+                "Scalable, Parallel Best-First Search for Optimal Sequential Planning",
+                "https://ojs.aaai.org/index.php/ICAPS/article/view/13350",
+                "Proceedings of the Nineteenth International Conference on "
+                "Automated Planning and Scheduling (ICAPS 2009)",
+                "201-208",
+                "AAAI Press",
+                "2009"));
+
+        add_option<shared_ptr<Evaluator>>(
+            "eval",
+            "evaluator for h-value. It is constructed once per thread.",
+            plugins::ArgumentInfo::NO_DEFAULT,
+            plugins::Bounds::unlimited(),
+            true);
+        add_option<int>(
+            "threads",
+            "number of worker threads",
+            "1",
+            plugins::Bounds("1", "infinity"));
+        add_option<search_common::AStarOpenList>(
+            "open_list",
+            "open list of each thread (see astar)",
+            "auto");
+        add_option<bool>(
+            "shared_registry",
+            "store the states of all threads in one thread-safe state "
+            "registry instead of one registry per thread (see below)",
+            "false");
+        SearchEngine::add_options_to_feature(*this);
+
+        document_note(
+            "Evaluators bound with let",
+            "Evaluators defined outside of the hdastar call (e.g., with "
+            "let) are shared between all threads, which is not supported "
+            "because evaluators are not thread-safe. Define the evaluator "
+            "inside the call instead.");
+        document_note(
+            "Shared registry",
+            "With shared_registry=true, a thread registers the successors "
+            "it generates itself, concurrently with the other threads, and "
+            "sends only their IDs to the threads that own them. The "
+            "registry consists of 16 shards per thread with separate locks. "
+            "Since state IDs are then global, the per-state data of each "
+            "thread (search nodes, heuristic caches) has entries for the "
+            "states of all threads, which needs more memory than separate "
+            "registries.");
+        document_note(
+            "Optimality",
+            "The search terminates once no thread has an open node with an "
+            "f value below the cost of the best solution found so far, so "
+            "plans are optimal if the evaluator is admissible. "
+            "Tasks with axioms are not supported.");
+    }
+};
+
+static plugins::FeaturePlugin<HDAStarSearchFeature> _plugin;
+}
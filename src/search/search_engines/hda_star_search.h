@@ -0,0 +1,184 @@
+#ifndef SEARCH_ENGINES_HDA_STAR_SEARCH_H
+#define SEARCH_ENGINES_HDA_STAR_SEARCH_H
+
+#include "search_common.h"
+
+#include "../open_list.h"
+#include "../per_state_information.h"
+#include "../search_engine.h"
+
+#include "../parser/decorated_abstract_syntax_tree.h"
+#include "../utils/countdown_timer.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ConcurrentStateRegistry;
+class Evaluator;
+
+/*
+  Hash-distributed A* (HDA*) search (Kishimoto, Fukunaga and Botea,
+  ICAPS 2009).
+
+  Every state is owned by exactly one worker thread, determined by the
+  hash of its packed representation. Each worker has its own state
+  registry, node table, open list and evaluator instances. A worker
+  expands the nodes of its own open list and sends generated successors
+  owned by other workers to them asynchronously via message queues.
+  Alternatively, all workers can share a ConcurrentStateRegistry: then a
+  worker registers the successors it generates itself and only sends
+  their IDs.
+
+  Termination: a worker that has no node with f < incumbent left is
+  idle. The counter "num_pending_work_items" counts active workers
+  plus messages that have been sent but not yet processed. It can only
+  increase while it is positive (an active worker sends a message, or
+  an idle worker receives one), so once it reaches 0 no work remains
+  anywhere and the incumbent solution (if any) is optimal for
+  admissible heuristics.
+*/
+namespace hda_star_search {
+class HDAStarSearch;
+
+struct HDAStarNodeInfo {
+    enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
+
+    unsigned int status : 2;
+    int g : 30;
+    int real_g;
+    // Parents may be owned by other workers.
+    int parent_worker;
+    StateID parent_state_id;
+    OperatorID creating_operator;
+
+    HDAStarNodeInfo()
+        : status(NEW), g(-1), real_g(-1), parent_worker(-1),
+          parent_state_id(StateID::no_state), creating_operator(-1) {
+    }
+};
+
+struct SuccessorMessage {
+    int g;
+    int real_g;
+    int parent_worker;
+    StateID parent_state_id;
+    OperatorID creating_operator;
+    // ID of the successor if the workers share a registry.
+    StateID state_id;
+
+    SuccessorMessage(int g, int real_g, int parent_worker,
+                     StateID parent_state_id, OperatorID creating_operator)
+        : g(g), real_g(real_g), parent_worker(parent_worker),
+          parent_state_id(parent_state_id),
+          creating_operator(creating_operator),
+          state_id(StateID::no_state) {
+    }
+};
+
+/*
+  Successors sent to a worker. Unless the workers share a registry, the
+  packed data of the i-th message is stored at bins
+  [i * num_bins, (i + 1) * num_bins).
+*/
+class MessageQueue {
+    std::mutex access_mutex;
+    std::vector<PackedStateBin> buffers;
+    std::vector<SuccessorMessage> messages;
+public:
+    void push(const std::vector<PackedStateBin> &new_buffers,
+              const std::vector<SuccessorMessage> &new_messages);
+    // Move all queued messages to the given (empty) vectors.
+    void pop_all(std::vector<PackedStateBin> &out_buffers,
+                 std::vector<SuccessorMessage> &out_messages);
+};
+
+class HDAStarWorker {
+    HDAStarSearch &engine;
+    const int id;
+    const int num_bins;
+    // Registry of this worker (nullptr if the workers share a registry).
+    std::unique_ptr<StateRegistry> own_registry;
+    StateRegistry &state_registry;
+    PerStateInformation<HDAStarNodeInfo> search_node_infos;
+    std::shared_ptr<Evaluator> f_evaluator;
+    std::unique_ptr<StateOpenList> open_list;
+    utils::LogProxy log;
+    SearchStatistics statistics;
+
+    MessageQueue inbox;
+    std::vector<PackedStateBin> received_buffers;
+    std::vector<SuccessorMessage> received_messages;
+    std::vector<std::vector<PackedStateBin>> outgoing_buffers;
+    std::vector<std::vector<SuccessorMessage>> outgoing_messages;
+    std::vector<PackedStateBin> successor_buffer;
+
+    bool active;
+    StateID best_goal_id;
+
+    void receive_successor(
+        const State &succ_state, const SuccessorMessage &message);
+    bool process_inbox();
+    bool expand_next_node();
+    void send_outgoing_messages();
+public:
+    HDAStarWorker(HDAStarSearch &engine, int id,
+                  const std::shared_ptr<Evaluator> &eval,
+                  utils::Verbosity verbosity);
+
+    void insert_initial_state(const PackedStateBin *buffer);
+    void run();
+
+    MessageQueue &get_inbox() {
+        return inbox;
+    }
+    const HDAStarNodeInfo &get_node_info(StateID id) const;
+    StateID get_best_goal_id() const {
+        return best_goal_id;
+    }
+    const SearchStatistics &get_statistics() const {
+        return statistics;
+    }
+    const StateRegistry &get_state_registry() const {
+        return state_registry;
+    }
+};
+
+class HDAStarSearch : public SearchEngine {
+    friend class HDAStarWorker;
+
+    const int num_threads;
+    const utils::Verbosity verbosity;
+    const search_common::AStarOpenList open_list_type;
+    parser::LazyValue eval_config;
+    const bool use_shared_registry;
+    // Must outlive the workers, whose per-state data refers to it.
+    std::unique_ptr<ConcurrentStateRegistry> shared_registry;
+    std::vector<std::unique_ptr<HDAStarWorker>> workers;
+
+    std::mutex incumbent_mutex;
+    std::atomic<int> incumbent_cost;
+    int incumbent_worker;
+    std::atomic<int> num_pending_work_items;
+    std::atomic<bool> timed_out;
+    std::unique_ptr<utils::CountdownTimer> timer;
+
+    int get_owner(const PackedStateBin *buffer) const;
+    bool report_solution(int worker, int cost);
+    void extract_plan();
+    void collect_statistics();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit HDAStarSearch(const plugins::Options &opts);
+    virtual ~HDAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "parallel_successor_evaluator.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+
+#include "../utils/system.h"
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+
+namespace eager_search {
+static shared_ptr<Evaluator> create_thread_copy(const Evaluator &evaluator) {
+    shared_ptr<Evaluator> copy = evaluator.create_thread_copy();
+    if (!copy) {
+        cerr << "Parallel evaluation does not support evaluator '"
+             << evaluator.get_description() << "'." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+    return copy;
+}
+
+ParallelSuccessorEvaluator::ParallelSuccessorEvaluator(
+    const vector<Evaluator *> &evaluators, int num_threads,
+    const State &initial_state)
+    : evaluators(evaluators),
+      batch_number(0),
+      num_busy_helpers(0),
+      stop(false),
+      batch(nullptr),
+      next_index(0) {
+    assert(num_threads >= 1);
+    evaluators_by_thread.push_back(evaluators);
+    for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+        vector<Evaluator *> thread_evaluators;
+        for (Evaluator *evaluator : evaluators) {
+            copies.push_back(create_thread_copy(*evaluator));
+            thread_evaluators.push_back(copies.back().get());
+        }
+        evaluators_by_thread.push_back(move(thread_evaluators));
+    }
+    /*
+      Per-state data of the copies (e.g., their heuristic caches)
+      subscribes to the state registry on first use. Evaluating the
+      initial state here makes sure that this happens in this thread.
+    */
+    EvaluationContext eval_context(initial_state, 0, true, nullptr);
+    for (const shared_ptr<Evaluator> &copy : copies) {
+        eval_context.get_result(copy.get());
+    }
+    for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+        helpers.emplace_back(&ParallelSuccessorEvaluator::run_helper, this,
+                             thread_id);
+    }
+}
+
+ParallelSuccessorEvaluator::~ParallelSuccessorEvaluator() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    batch_started.notify_all();
+    for (thread &helper : helpers) {
+        helper.join();
+    }
+}
+
+void ParallelSuccessorEvaluator::evaluate_claimed_successors(int thread_id) {
+    const vector<Evaluator *> &thread_evaluators =
+        evaluators_by_thread[thread_id];
+    int num_successors = batch->size();
+    for (;;) {
+        int index = next_index.fetch_add(1, memory_order_relaxed);
+        if (index >= num_successors)
+            break;
+        SuccessorEvaluation &successor = (*batch)[index];
+        successor.thread_id = thread_id;
+        EvaluationContext eval_context(
+            successor.state, successor.g, successor.is_preferred, nullptr);
+        eval_context.set_upper_bound_hint(successor.upper_bound_hint);
+        for (size_t i = 0; i < evaluators.size(); ++i) {
+            const EvaluationResult &result =
+                eval_context.get_result(thread_evaluators[i]);
+            successor.results[evaluators[i]] = result;
+            if (evaluators[i]->is_used_for_counting_evaluations() &&
+                result.get_count_evaluation()) {
+                ++successor.num_evaluations;
+            }
+        }
+    }
+}
+
+void ParallelSuccessorEvaluator::run_helper(int thread_id) {
+    uint64_t last_batch_number = 0;
+    for (;;) {
+        {
+            unique_lock<std::mutex> lock(mutex);
+            batch_started.wait(lock, [&] {
+                                   return stop || batch_number != last_batch_number;
+                               });
+            if (stop)
+                return;
+            last_batch_number = batch_number;
+        }
+        evaluate_claimed_successors(thread_id);
+        {
+            lock_guard<std::mutex> lock(mutex);
+            --num_busy_helpers;
+        }
+        batch_finished.notify_one();
+    }
+}
+
+void ParallelSuccessorEvaluator::copy_cached_estimates(
+    const SuccessorEvaluation &successor) {
+    const vector<Evaluator *> &thread_evaluators =
+        evaluators_by_thread[successor.thread_id];
+    for (size_t i = 0; i < evaluators.size(); ++i) {
+        if (evaluators[i]->does_cache_estimates() &&
+            thread_evaluators[i]->is_estimate_cached(successor.state)) {
+            evaluators[i]->set_cached_estimate(
+                successor.state,
+                thread_evaluators[i]->get_cached_estimate(successor.state));
+        }
+    }
+}
+
+void ParallelSuccessorEvaluator::evaluate(
+    vector<SuccessorEvaluation> &successors) {
+    batch = &successors;
+    next_index.store(0, memory_order_relaxed);
+    if (successors.size() <= 1 || helpers.empty()) {
+        evaluate_claimed_successors(0);
+        return;
+    }
+    {
+        lock_guard<std::mutex> lock(mutex);
+        ++batch_number;
+        num_busy_helpers = helpers.size();
+    }
+    batch_started.notify_all();
+    evaluate_claimed_successors(0);
+    {
+        unique_lock<std::mutex> lock(mutex);
+        batch_finished.wait(lock, [&] {return num_busy_helpers == 0;});
+    }
+    for (const SuccessorEvaluation &successor : successors) {
+        if (successor.thread_id != 0)
+            copy_cached_estimates(successor);
+    }
+}
+}
@@ -0,0 +1,83 @@
+#ifndef SEARCH_ENGINES_PARALLEL_SUCCESSOR_EVALUATOR_H
+#define SEARCH_ENGINES_PARALLEL_SUCCESSOR_EVALUATOR_H
+
+#include "../evaluator_cache.h"
+#include "../task_proxy.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Evaluator;
+
+namespace eager_search {
+struct SuccessorEvaluation {
+    State state;
+    int g;
+    bool is_preferred;
+    int upper_bound_hint;
+    // Results keyed by the evaluators of the search (not by the copies).
+    EvaluatorCache results;
+    int num_evaluations;
+    int thread_id;
+
+    SuccessorEvaluation(const State &state, int g, bool is_preferred,
+                        int upper_bound_hint)
+        : state(state), g(g), is_preferred(is_preferred),
+          upper_bound_hint(upper_bound_hint), num_evaluations(0),
+          thread_id(-1) {
+    }
+};
+
+/*
+  Computes the values of a fixed set of (path-independent) evaluators
+  for batches of states on a pool of threads.
+
+  The calling thread takes part in each batch with the evaluators of
+  the search. Every other thread uses its own copies, which are created
+  with Evaluator::create_thread_copy, so evaluators do not need to be
+  thread-safe. The constructor aborts the search if an evaluator does
+  not support this. States are claimed with an atomic counter; the
+  threads only synchronize at the start and end of each batch.
+  Estimates that the copies cache are copied to the caches of the
+  original evaluators after each batch.
+
+  All states of a batch must belong to the registry of the state that
+  is passed to the constructor, and this registry must not be modified
+  during a batch.
+*/
+class ParallelSuccessorEvaluator {
+    const std::vector<Evaluator *> evaluators;
+    std::vector<std::shared_ptr<Evaluator>> copies;
+    // evaluators_by_thread[i][j]: instance of evaluator j used by thread i.
+    std::vector<std::vector<Evaluator *>> evaluators_by_thread;
+    std::vector<std::thread> helpers;
+
+    std::mutex mutex;
+    std::condition_variable batch_started;
+    std::condition_variable batch_finished;
+    uint64_t batch_number;
+    int num_busy_helpers;
+    bool stop;
+
+    std::vector<SuccessorEvaluation> *batch;
+    std::atomic<int> next_index;
+
+    void evaluate_claimed_successors(int thread_id);
+    void run_helper(int thread_id);
+    void copy_cached_estimates(const SuccessorEvaluation &successor);
+public:
+    ParallelSuccessorEvaluator(
+        const std::vector<Evaluator *> &evaluators, int num_threads,
+        const State &initial_state);
+    ~ParallelSuccessorEvaluator();
+
+    void evaluate(std::vector<SuccessorEvaluation> &successors);
+};
+}
+
+#endif
@@ -20,6 +20,10 @@ public:
             "lazy_evaluator",
             "An evaluator that re-evaluates a state before it is expanded.",
             plugins::ArgumentInfo::NO_DEFAULT);
+        add_option<search_common::AStarOpenList>(
+            "open_list",
+            "open list used for ordering the states by g+h and h",
+            "auto");
         eager_search::add_options_to_feature(*this);
 
         document_note(
@@ -28,6 +32,13 @@ public:
             "re-evaluates s. If h(s) changes (for example because h is path-dependent), "
             "s is not expanded, but instead reinserted into the open list. "
             "This option is currently only present for the A* algorithm.");
+        document_note(
+            "open_list",
+            "Both open lists expand states in the same order. The bucket-based "
+            "open list needs less time per operation, but its memory usage "
+            "grows with the range of f values. With 'auto', it is used if "
+            "no operator costs more than 100 (after adjusting the costs "
+            "according to cost_type).");
         document_note(
             "Equivalent statements using general eager search",
             "\n```\n--search astar(evaluator)\n```\n"
@@ -51,4 +62,10 @@ public:
 };
 
 static plugins::FeaturePlugin<AStarSearchFeature> _plugin;
+
+static plugins::TypedEnumPlugin<search_common::AStarOpenList> _enum_plugin({
+    {"auto", "choose depending on the operator costs of the task"},
+    {"buckets", "bucket-based open list"},
+    {"tiebreaking", "tie-breaking open list"}
+});
 }
@@ -2,13 +2,19 @@
 
 #include "../open_list_factory.h"
 
+#include "../operator_cost.h"
+#include "../task_proxy.h"
+
 #include "../evaluators/g_evaluator.h"
 #include "../evaluators/sum_evaluator.h"
 #include "../evaluators/weighted_evaluator.h"
 #include "../plugins/options.h"
 #include "../open_lists/alternation_open_list.h"
 #include "../open_lists/best_first_open_list.h"
+#include "../open_lists/bucket_open_list.h"
 #include "../open_lists/tiebreaking_open_list.h"
+#include "../task_utils/task_properties.h"
+#include "../tasks/root_task.h"
 
 #include <memory>
 
@@ -125,6 +131,26 @@ shared_ptr<OpenListFactory> create_wastar_open_list_factory(
         options.get<int>("boost"));
 }
 
+static const int MAX_COST_FOR_AUTO_BUCKETS = 100;
+
+static bool use_buckets_for_astar(const plugins::Options &opts) {
+    AStarOpenList type = opts.get<AStarOpenList>("open_list");
+    if (type != AStarOpenList::AUTO)
+        return type == AStarOpenList::BUCKETS;
+    if (!tasks::g_root_task)
+        return false;
+    TaskProxy task_proxy(*tasks::g_root_task);
+    OperatorCost cost_type = opts.get<OperatorCost>("cost_type");
+    bool is_unit_cost = task_properties::is_unit_cost(task_proxy);
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        if (get_adjusted_action_cost(op, cost_type, is_unit_cost) >
+            MAX_COST_FOR_AUTO_BUCKETS) {
+            return false;
+        }
+    }
+    return true;
+}
+
 pair<shared_ptr<OpenListFactory>, const shared_ptr<Evaluator>>
 create_astar_open_list_factory_and_f_eval(const plugins::Options &opts) {
     plugins::Options g_evaluator_options;
@@ -144,8 +170,13 @@ create_astar_open_list_factory_and_f_eval(const plugins::Options &opts) {
     options.set("evals", evals);
     options.set("pref_only", false);
     options.set("unsafe_pruning", false);
-    shared_ptr<OpenListFactory> open =
-        make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(options);
+    shared_ptr<OpenListFactory> open;
+    if (use_buckets_for_astar(opts)) {
+        options.set("lifo", false);
+        open = make_shared<bucket_open_list::BucketOpenListFactory>(options);
+    } else {
+        open = make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(options);
+    }
     return make_pair(open, f);
 }
 }
@@ -28,6 +28,12 @@ class Options;
 }
 
 namespace search_common {
+enum class AStarOpenList {
+    AUTO,
+    BUCKETS,
+    TIEBREAKING
+};
+
 /*
   Create a standard scalar open list factory with the given "eval" and
   "pref_only" options.
@@ -71,9 +77,13 @@ extern std::shared_ptr<OpenListFactory> create_wastar_open_list_factory(
   Create open list factory and f_evaluator (used for displaying progress
   statistics) for A* search.
 
-  The resulting open list factory produces a tie-breaking open list
-  ordered primarily on g + h and secondarily on h. Uses "eval" from
-  the passed-in Options object as the h evaluator.
+  The resulting open list factory produces an open list ordered
+  primarily on g + h and secondarily on h. Uses "eval" from the
+  passed-in Options object as the h evaluator. The option "open_list"
+  selects between a bucket-based and a tie-breaking open list. With
+  AUTO, buckets are used if no operator costs more than
+  MAX_COST_FOR_AUTO_BUCKETS (after adjusting costs according to
+  "cost_type"), so that the range of f values stays small.
 */
 extern std::pair<std::shared_ptr<OpenListFactory>, const std::shared_ptr<Evaluator>>
 create_astar_open_list_factory_and_f_eval(const plugins::Options &opts);
@@ -7,18 +7,20 @@
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
+/*
+  Part of a search node that every search needs. The parent state and
+  the g value according to the real operator costs are stored separately
+  by the SearchSpace, because they are not always needed (see there).
+*/
 struct SearchNodeInfo {
     enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
 
     unsigned int status : 2;
     int g : 30;
-    StateID parent_state_id;
     OperatorID creating_operator;
-    int real_g;
 
     SearchNodeInfo()
-        : status(NEW), g(-1), parent_state_id(StateID::no_state),
-          creating_operator(-1), real_g(-1) {
+        : status(NEW), g(-1), creating_operator(-1) {
     }
 };
 
@@ -3,15 +3,19 @@
 #include "search_node_info.h"
 #include "task_proxy.h"
 
+#include "algorithms/int_packer.h"
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
 
-SearchNode::SearchNode(const State &state, SearchNodeInfo &info)
-    : state(state), info(info) {
+SearchNode::SearchNode(const State &state, SearchNodeInfo &info,
+                       StateID *parent_state_id, int *real_g)
+    : state(state), info(info), parent_state_id(parent_state_id),
+      real_g(real_g) {
     assert(state.get_id() != StateID::no_state);
 }
 
@@ -41,15 +45,28 @@ int SearchNode::get_g() const {
 }
 
 int SearchNode::get_real_g() const {
-    return info.real_g;
+    return real_g ? *real_g : info.g;
+}
+
+void SearchNode::set_parent(const SearchNode &parent_node,
+                            const OperatorProxy &parent_op,
+                            int adjusted_cost) {
+    info.g = parent_node.info.g + adjusted_cost;
+    if (real_g)
+        *real_g = parent_node.get_real_g() + parent_op.get_cost();
+    if (parent_state_id)
+        *parent_state_id = parent_node.get_state().get_id();
+    info.creating_operator = OperatorID(parent_op.get_id());
 }
 
 void SearchNode::open_initial() {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
     info.g = 0;
-    info.real_g = 0;
-    info.parent_state_id = StateID::no_state;
+    if (real_g)
+        *real_g = 0;
+    if (parent_state_id)
+        *parent_state_id = StateID::no_state;
     info.creating_operator = OperatorID::no_operator;
 }
 
@@ -58,10 +75,7 @@ void SearchNode::open(const SearchNode &parent_node,
                       int adjusted_cost) {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::reopen(const SearchNode &parent_node,
@@ -73,10 +87,7 @@ void SearchNode::reopen(const SearchNode &parent_node,
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
     info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 // like reopen, except doesn't change status
@@ -87,10 +98,7 @@ void SearchNode::update_parent(const SearchNode &parent_node,
            info.status == SearchNodeInfo::CLOSED);
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::close() {
@@ -109,20 +117,148 @@ void SearchNode::dump(const TaskProxy &task_proxy, utils::LogProxy &log) const {
         if (info.creating_operator != OperatorID::no_operator) {
             OperatorsProxy operators = task_proxy.get_operators();
             OperatorProxy op = operators[info.creating_operator.get_index()];
-            log << " created by " << op.get_name()
-                << " from " << info.parent_state_id << endl;
+            log << " created by " << op.get_name();
+            if (parent_state_id)
+                log << " from " << *parent_state_id;
+            log << endl;
         } else {
             log << " no parent" << endl;
         }
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry &state_registry, utils::LogProxy &log)
-    : state_registry(state_registry), log(log) {
+SearchSpace::SearchSpace(StateRegistry &state_registry, OperatorCost cost_type,
+                         bool store_parent_pointers, utils::LogProxy &log)
+    : parent_state_ids(StateID::no_state),
+      real_gs(-1),
+      state_registry(state_registry),
+      cost_type(cost_type),
+      is_unit_cost(task_properties::is_unit_cost(
+                       state_registry.get_task_proxy())),
+      store_parent_pointers(store_parent_pointers),
+      store_real_g(cost_type != OperatorCost::NORMAL),
+      log(log) {
 }
 
 SearchNode SearchSpace::get_node(const State &state) {
-    return SearchNode(state, search_node_infos[state]);
+    return SearchNode(
+        state, search_node_infos[state],
+        store_parent_pointers ? &parent_state_ids[state] : nullptr,
+        store_real_g ? &real_gs[state] : nullptr);
+}
+
+vector<StateID> SearchSpace::get_possible_predecessors(const State &state) const {
+    OperatorProxy op = state_registry.get_task_proxy().get_operators()[
+        search_node_infos[state].creating_operator];
+    int max_g = search_node_infos[state].g -
+        get_adjusted_action_cost(op, cost_type, is_unit_cost);
+
+    /*
+      Predecessors can only differ from the state in variables that the
+      operator or the axioms change. We compute a bit mask of the bins of
+      the packed state data that belong to these variables, so that most
+      states can be ruled out by comparing their packed data.
+    */
+    const int_packer::IntPacker &packer = state_registry.get_state_packer();
+    int num_bins = packer.get_num_bins();
+    vector<PackedStateBin> changeable_bits(num_bins, 0);
+    vector<PackedStateBin> buffer(num_bins);
+    auto add_variable = [&](VariableProxy var) {
+            for (int value = 0; value < var.get_domain_size(); ++value) {
+                fill(buffer.begin(), buffer.end(), 0);
+                packer.set(buffer.data(), var.get_id(), value);
+                for (int i = 0; i < num_bins; ++i)
+                    changeable_bits[i] |= buffer[i];
+            }
+        };
+    for (EffectProxy effect : op.get_effects())
+        add_variable(effect.get_fact().get_variable());
+    for (VariableProxy var : state_registry.get_task_proxy().get_variables()) {
+        if (var.is_derived())
+            add_variable(var);
+    }
+
+    const PackedStateBin *state_buffer = state.get_buffer();
+    vector<StateID> predecessors;
+    for (StateID id : state_registry) {
+        if (id == state.get_id())
+            continue;
+        State candidate = state_registry.lookup_state(id);
+        const SearchNodeInfo &info = search_node_infos[candidate];
+        /*
+          Only expanded states and states on the open list were reached
+          with their g value. States marked as dead ends before they were
+          opened have no g value.
+        */
+        if ((info.status != SearchNodeInfo::OPEN &&
+             info.status != SearchNodeInfo::CLOSED) || info.g > max_g)
+            continue;
+        const PackedStateBin *candidate_buffer = candidate.get_buffer();
+        bool may_be_predecessor = true;
+        for (int i = 0; i < num_bins; ++i) {
+            if ((candidate_buffer[i] ^ state_buffer[i]) & ~changeable_bits[i]) {
+                may_be_predecessor = false;
+                break;
+            }
+        }
+        if (!may_be_predecessor ||
+            !task_properties::is_applicable(op, candidate))
+            continue;
+        state_registry.compute_successor_buffer(candidate, op, buffer.data());
+        if (equal(buffer.begin(), buffer.end(), state_buffer))
+            predecessors.push_back(id);
+    }
+    return predecessors;
+}
+
+void SearchSpace::reconstruct_path(const State &goal_state,
+                                   vector<OperatorID> &path) const {
+    /*
+      The actual parent of every reached state (except the initial state)
+      is among its possible predecessors, so the initial state is always
+      reachable backwards from the goal. With zero-cost operators, a
+      possible predecessor can lead into a cycle, so we use a depth-first
+      search that never revisits states.
+    */
+    log << "Reconstructing plan from " << state_registry.size()
+        << " registered states..." << endl;
+    struct Frame {
+        State state;
+        vector<StateID> predecessors;
+        size_t next_predecessor;
+    };
+    StateID initial_state_id = state_registry.get_initial_state().get_id();
+    PerStateInformation<bool> visited(false);
+    vector<Frame> stack;
+    visited[goal_state] = true;
+    stack.push_back({
+            goal_state,
+            goal_state.get_id() == initial_state_id
+            ? vector<StateID>() : get_possible_predecessors(goal_state),
+            0});
+    while (stack.back().state.get_id() != initial_state_id) {
+        Frame &frame = stack.back();
+        if (frame.next_predecessor == frame.predecessors.size()) {
+            stack.pop_back();
+            assert(!stack.empty());
+            continue;
+        }
+        State predecessor = state_registry.lookup_state(
+            frame.predecessors[frame.next_predecessor++]);
+        if (!visited[predecessor]) {
+            visited[predecessor] = true;
+            vector<StateID> predecessors =
+                predecessor.get_id() == initial_state_id
+                ? vector<StateID>() : get_possible_predecessors(predecessor);
+            stack.push_back({move(predecessor), move(predecessors), 0});
+        }
+    }
+    // The initial state is at the top of the stack.
+    for (size_t i = 0; i + 1 < stack.size(); ++i) {
+        OperatorID op_id = search_node_infos[stack[i].state].creating_operator;
+        assert(op_id != OperatorID::no_operator);
+        path.push_back(op_id);
+    }
 }
 
 void SearchSpace::trace_path(const State &goal_state,
@@ -130,14 +266,19 @@ void SearchSpace::trace_path(const State &goal_state,
     State current_state = goal_state;
     assert(current_state.get_registry() == &state_registry);
     assert(path.empty());
-    for (;;) {
-        const SearchNodeInfo &info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
-            break;
+    if (!store_parent_pointers) {
+        reconstruct_path(goal_state, path);
+    } else {
+        for (;;) {
+            const SearchNodeInfo &info = search_node_infos[current_state];
+            if (info.creating_operator == OperatorID::no_operator) {
+                assert(parent_state_ids[current_state] == StateID::no_state);
+                break;
+            }
+            path.push_back(info.creating_operator);
+            current_state = state_registry.lookup_state(
+                parent_state_ids[current_state]);
         }
-        path.push_back(info.creating_operator);
-        current_state = state_registry.lookup_state(info.parent_state_id);
     }
     reverse(path.begin(), path.end());
 }
@@ -151,11 +292,12 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
         const SearchNodeInfo &node_info = search_node_infos[state];
         log << id << ": ";
         task_properties::dump_fdr(state);
-        if (node_info.creating_operator != OperatorID::no_operator &&
-            node_info.parent_state_id != StateID::no_state) {
+        if (node_info.creating_operator != OperatorID::no_operator) {
             OperatorProxy op = operators[node_info.creating_operator.get_index()];
-            log << " created by " << op.get_name()
-                << " from " << node_info.parent_state_id << endl;
+            log << " created by " << op.get_name();
+            if (store_parent_pointers)
+                log << " from " << parent_state_ids[state];
+            log << endl;
         } else {
             log << "has no parent" << endl;
         }
@@ -18,8 +18,17 @@ class LogProxy;
 class SearchNode {
     State state;
     SearchNodeInfo &info;
+    // nullptr if the search space does not store parent pointers.
+    StateID *parent_state_id;
+    // nullptr if the search space does not store real g values separately.
+    int *real_g;
+
+    void set_parent(const SearchNode &parent_node,
+                    const OperatorProxy &parent_op,
+                    int adjusted_cost);
 public:
-    SearchNode(const State &state, SearchNodeInfo &info);
+    SearchNode(const State &state, SearchNodeInfo &info,
+               StateID *parent_state_id, int *real_g);
 
     const State &get_state() const;
 
@@ -48,13 +57,39 @@ public:
 };
 
 
+/*
+  Stores a SearchNodeInfo for every state. Two further parts of a search
+  node are only stored if they are needed:
+
+  - The g value according to the real operator costs is only stored if
+    the search uses other costs (cost_type != normal). Otherwise, it
+    equals the g value.
+  - The parent state of each node is only stored if store_parent_pointers
+    is true. Otherwise, trace_path() reconstructs the path by searching
+    backwards from the goal over the registered states: a state is a
+    possible predecessor of s if it has been reached, its g value plus
+    the cost of the creating operator of s is at most g(s), and applying
+    this operator to it leads to s. This saves 4 bytes per state but
+    looks at all registered states once per step of the path.
+*/
 class SearchSpace {
     PerStateInformation<SearchNodeInfo> search_node_infos;
+    PerStateInformation<StateID> parent_state_ids;
+    PerStateInformation<int> real_gs;
 
     StateRegistry &state_registry;
+    const OperatorCost cost_type;
+    const bool is_unit_cost;
+    const bool store_parent_pointers;
+    const bool store_real_g;
     utils::LogProxy &log;
+
+    std::vector<StateID> get_possible_predecessors(const State &state) const;
+    void reconstruct_path(const State &goal_state,
+                          std::vector<OperatorID> &path) const;
 public:
-    SearchSpace(StateRegistry &state_registry, utils::LogProxy &log);
+    SearchSpace(StateRegistry &state_registry, OperatorCost cost_type,
+                bool store_parent_pointers, utils::LogProxy &log);
 
     SearchNode get_node(const State &state);
     void trace_path(const State &goal_state,
@@ -53,6 +53,7 @@ public:
     int get_evaluations() const {return evaluations;}
     int get_generated() const {return generated_states;}
     int get_reopened() const {return reopened_states;}
+    int get_dead_ends() const {return dead_end_states;}
     int get_generated_ops() const {return generated_ops;}
 
     /*
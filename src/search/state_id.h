@@ -8,6 +8,8 @@
 
 class StateID {
     friend class StateRegistry;
+    friend class ConcurrentStateRegistry;
+    friend class CompressedStateRegistry;
     friend std::ostream &operator<<(std::ostream &os, StateID id);
     template<typename>
     friend class PerStateInformation;
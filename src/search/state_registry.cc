@@ -13,6 +13,7 @@ StateRegistry::StateRegistry(const TaskProxy &task_proxy)
       state_packer(task_properties::g_state_packers[task_proxy]),
       axiom_evaluator(g_axiom_evaluators[task_proxy]),
       num_variables(task_proxy.get_variables().size()),
+      num_states(0),
       state_data_pool(get_bins_per_state()),
       registered_states(
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
@@ -20,6 +21,12 @@ StateRegistry::StateRegistry(const TaskProxy &task_proxy)
 }
 
 StateID StateRegistry::insert_id_or_pop_state() {
+    const PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
+    return insert_id_or_pop_state(
+        get_packed_state_hash(buffer, get_bins_per_state()));
+}
+
+StateID StateRegistry::insert_id_or_pop_state(int_hash_set::HashType hash) {
     /*
       Attempt to insert a StateID for the last state of state_data_pool
       if none is present yet. If this fails (another entry for this state
@@ -27,9 +34,11 @@ StateID StateRegistry::insert_id_or_pop_state() {
       state data pool.
     */
     StateID id(state_data_pool.size() - 1);
-    pair<int, bool> result = registered_states.insert(id.value);
+    pair<int, bool> result = registered_states.insert_with_hash(id.value, hash);
     bool is_new_entry = result.second;
-    if (!is_new_entry) {
+    if (is_new_entry) {
+        num_states.store(registered_states.size(), memory_order_relaxed);
+    } else {
         state_data_pool.pop_back();
     }
     assert(registered_states.size() == static_cast<int>(state_data_pool.size()));
@@ -52,9 +61,8 @@ const State &StateRegistry::get_initial_state() {
         for (size_t i = 0; i < initial_state.size(); ++i) {
             state_packer.set(buffer.get(), i, initial_state[i].get_value());
         }
-        state_data_pool.push_back(buffer.get());
-        StateID id = insert_id_or_pop_state();
-        cached_initial_state = utils::make_unique_ptr<State>(lookup_state(id));
+        cached_initial_state = utils::make_unique_ptr<State>(
+            insert_state(buffer.get()));
     }
     return *cached_initial_state;
 }
@@ -95,6 +103,87 @@ State StateRegistry::get_successor_state(const State &predecessor, const Operato
     }
 }
 
+void StateRegistry::get_successor_states(
+    const State &predecessor, span<const OperatorID> operator_ids,
+    vector<State> &successors) {
+    OperatorsProxy operators = task_proxy.get_operators();
+    if (task_properties::has_axioms(task_proxy)) {
+        for (OperatorID op_id : operator_ids) {
+            successors.push_back(
+                get_successor_state(predecessor, operators[op_id]));
+        }
+        return;
+    }
+
+    int num_bins = get_bins_per_state();
+    int num_successors = operator_ids.size();
+    successor_buffers.resize(num_successors * num_bins);
+    successor_hashes.resize(num_successors);
+    const PackedStateBin *predecessor_buffer = predecessor.get_buffer();
+    for (int i = 0; i < num_successors; ++i) {
+        OperatorProxy op = operators[operator_ids[i]];
+        assert(!op.is_axiom());
+        PackedStateBin *buffer = &successor_buffers[i * num_bins];
+        copy(predecessor_buffer, predecessor_buffer + num_bins, buffer);
+        for (EffectProxy effect : op.get_effects()) {
+            if (does_fire(effect, predecessor)) {
+                FactPair effect_pair = effect.get_fact().get_pair();
+                state_packer.set(buffer, effect_pair.var, effect_pair.value);
+            }
+        }
+    }
+
+    for (int i = 0; i < num_successors; ++i) {
+        successor_hashes[i] = get_packed_state_hash(
+            &successor_buffers[i * num_bins], num_bins);
+        registered_states.prefetch(successor_hashes[i]);
+    }
+
+    for (int i = 0; i < num_successors; ++i) {
+        state_data_pool.push_back(&successor_buffers[i * num_bins]);
+        StateID id = insert_id_or_pop_state(successor_hashes[i]);
+        successors.push_back(lookup_state(id));
+    }
+}
+
+void StateRegistry::compute_successor_buffer(
+    const State &predecessor, const OperatorProxy &op,
+    PackedStateBin *buffer) const {
+    assert(!op.is_axiom());
+    int num_bins = get_bins_per_state();
+    if (task_properties::has_axioms(task_proxy)) {
+        predecessor.unpack();
+        vector<int> new_values = predecessor.get_unpacked_values();
+        for (EffectProxy effect : op.get_effects()) {
+            if (does_fire(effect, predecessor)) {
+                FactPair effect_pair = effect.get_fact().get_pair();
+                new_values[effect_pair.var] = effect_pair.value;
+            }
+        }
+        axiom_evaluator.evaluate(new_values);
+        // Avoid garbage values in half-full bins.
+        fill_n(buffer, num_bins, 0);
+        for (size_t i = 0; i < new_values.size(); ++i) {
+            state_packer.set(buffer, i, new_values[i]);
+        }
+    } else {
+        const PackedStateBin *predecessor_buffer = predecessor.get_buffer();
+        copy(predecessor_buffer, predecessor_buffer + num_bins, buffer);
+        for (EffectProxy effect : op.get_effects()) {
+            if (does_fire(effect, predecessor)) {
+                FactPair effect_pair = effect.get_fact().get_pair();
+                state_packer.set(buffer, effect_pair.var, effect_pair.value);
+            }
+        }
+    }
+}
+
+State StateRegistry::insert_state(const PackedStateBin *buffer) {
+    state_data_pool.push_back(buffer);
+    StateID id = insert_id_or_pop_state();
+    return lookup_state(id);
+}
+
 int StateRegistry::get_bins_per_state() const {
     return state_packer.get_num_bins();
 }
@@ -3,6 +3,7 @@
 
 #include "abstract_task.h"
 #include "axioms.h"
+#include "operator_id.h"
 #include "state_id.h"
 
 #include "algorithms/int_hash_set.h"
@@ -11,7 +12,10 @@
 #include "algorithms/subscriber.h"
 #include "utils/hash.h"
 
+#include <atomic>
 #include <set>
+#include <span>
+#include <vector>
 
 /*
   Overview of classes relevant to storing and working with registered states.
@@ -54,6 +58,10 @@
     The StateRegistry also stores the actual state data in a memory friendly way.
     It uses the following class:
 
+  ConcurrentStateRegistry
+    A variant of the StateRegistry that allows several threads to register
+    and look up states concurrently (see concurrent_state_registry.h).
+
   SegmentedArrayVector<PackedStateBin>
     This class is used to store the actual (packed) state data for all states
     while avoiding dynamically allocating each state individually.
@@ -90,7 +98,8 @@
 
     SearchSpace
       The SearchSpace uses PerStateInformation<SearchNodeInfo> to map StateIDs to
-      SearchNodeInfos. The open lists only have to store StateIDs which can be
+      SearchNodeInfos (and further PerStateInformation objects for the parts
+      of search nodes that are not always needed). The open lists only have to store StateIDs which can be
       used to look up a search node in the SearchSpace on demand.
 
   ---------------
@@ -113,6 +122,7 @@ using PackedStateBin = int_packer::IntPacker::Bin;
 
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+protected:
     struct StateIDSemanticHash {
         const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
         int state_size;
@@ -124,12 +134,7 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
         }
 
         int_hash_set::HashType operator()(int id) const {
-            const PackedStateBin *data = state_data_pool[id];
-            utils::HashState hash_state;
-            for (int i = 0; i < state_size; ++i) {
-                hash_state.feed(data[i]);
-            }
-            return hash_state.get_hash32();
+            return get_packed_state_hash(state_data_pool[id], state_size);
         }
     };
 
@@ -162,15 +167,29 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     AxiomEvaluator &axiom_evaluator;
     const int num_variables;
 
+    /*
+      Number of registered states. This is an atomic so that thread-safe
+      derived classes (see ConcurrentStateRegistry) can assign IDs from it.
+      Relaxed loads and stores of it are as cheap as plain accesses.
+    */
+    std::atomic<size_t> num_states;
+
+    int get_bins_per_state() const;
+private:
     segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
     StateIDSet registered_states;
 
     std::unique_ptr<State> cached_initial_state;
 
+    // Scratch space for get_successor_states().
+    std::vector<PackedStateBin> successor_buffers;
+    std::vector<int_hash_set::HashType> successor_hashes;
+
     StateID insert_id_or_pop_state();
-    int get_bins_per_state() const;
+    StateID insert_id_or_pop_state(int_hash_set::HashType hash);
 public:
     explicit StateRegistry(const TaskProxy &task_proxy);
+    virtual ~StateRegistry() override = default;
 
     const TaskProxy &get_task_proxy() const {
         return task_proxy;
@@ -188,7 +207,7 @@ public:
       Returns the state that was registered at the given ID. The ID must refer
       to a state in this registry. Do not mix IDs from from different registries.
     */
-    State lookup_state(StateID id) const;
+    virtual State lookup_state(StateID id) const;
 
     /*
       Returns a reference to the initial state and registers it if this was not
@@ -201,18 +220,65 @@ public:
       registers it if this was not done before. This is an expensive operation
       as it includes duplicate checking.
     */
-    State get_successor_state(const State &predecessor, const OperatorProxy &op);
+    virtual State get_successor_state(
+        const State &predecessor, const OperatorProxy &op);
+
+    /*
+      Appends the successors of predecessor for the given operators to
+      successors (in the order of the operators) and registers them if this
+      was not done before. The result is the same as calling
+      get_successor_state() for each operator, but for many operators this
+      is cheaper: all successors are computed and hashed first and the
+      buckets of the hash set are prefetched before the duplicate checks.
+    */
+    virtual void get_successor_states(
+        const State &predecessor, std::span<const OperatorID> operator_ids,
+        std::vector<State> &successors);
+
+    /*
+      Writes the packed data of the state that results from applying op to
+      predecessor into buffer, which must have room for get_num_bins() bins.
+      In contrast to get_successor_state(), the successor is not registered.
+    */
+    void compute_successor_buffer(
+        const State &predecessor, const OperatorProxy &op,
+        PackedStateBin *buffer) const;
+
+    /*
+      Returns the state with the given packed data (e.g., computed by
+      compute_successor_buffer() of another registry for the same task) and
+      registers it if this was not done before.
+    */
+    virtual State insert_state(const PackedStateBin *buffer);
+
+    /*
+      Returns the hash of the given packed state data that is used for
+      duplicate detection. Parallel search algorithms also use it to
+      distribute states among threads.
+    */
+    static int_hash_set::HashType get_packed_state_hash(
+        const PackedStateBin *buffer, int num_bins) {
+        utils::HashState hash_state;
+        for (int i = 0; i < num_bins; ++i) {
+            hash_state.feed(buffer[i]);
+        }
+        return hash_state.get_hash32();
+    }
+
+    int get_num_bins() const {
+        return get_bins_per_state();
+    }
 
     /*
       Returns the number of states registered so far.
     */
     size_t size() const {
-        return registered_states.size();
+        return num_states.load(std::memory_order_relaxed);
     }
 
     int get_state_size_in_bytes() const;
 
-    void print_statistics(utils::LogProxy &log) const;
+    virtual void print_statistics(utils::LogProxy &log) const;
 
     class const_iterator {
         using iterator_category = std::forward_iterator_tag;
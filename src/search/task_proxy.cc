@@ -28,6 +28,12 @@ State::State(const AbstractTask &task, const StateRegistry &registry,
     this->values = make_shared<vector<int>>(move(values));
 }
 
+State::State(const AbstractTask &task, const StateRegistry &registry,
+             StateID id, shared_ptr<const vector<PackedStateBin>> &&owned_buffer)
+    : State(task, registry, id, owned_buffer->data()) {
+    this->owned_buffer = move(owned_buffer);
+}
+
 State::State(const AbstractTask &task, vector<int> &&values)
     : task(&task), registry(nullptr), id(StateID::no_state), buffer(nullptr),
       values(make_shared<vector<int>>(move(values))),
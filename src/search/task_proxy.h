@@ -579,6 +579,12 @@ class State {
       semantics of the state".
     */
     mutable std::shared_ptr<std::vector<int>> values;
+    /*
+      Registries that store states in compressed form unpack them into a
+      buffer that is owned by the state. In this case, buffer points into
+      owned_buffer, which is nullptr otherwise.
+    */
+    std::shared_ptr<const std::vector<PackedStateBin>> owned_buffer;
     const int_packer::IntPacker *state_packer;
     int num_variables;
 public:
@@ -590,6 +596,9 @@ public:
     // Construct a registered state with packed and unpacked data.
     State(const AbstractTask &task, const StateRegistry &registry, StateID id,
           const PackedStateBin *buffer, std::vector<int> &&values);
+    // Construct a registered state that owns its packed data.
+    State(const AbstractTask &task, const StateRegistry &registry, StateID id,
+          std::shared_ptr<const std::vector<PackedStateBin>> &&owned_buffer);
     // Construct a state with only unpacked data.
     State(const AbstractTask &task, std::vector<int> &&values);
 
@@ -699,6 +708,13 @@ public:
         return State(*task, registry, id, buffer, std::move(state_values));
     }
 
+    // This method is meant to be called only by the state registry.
+    State create_state(
+        const StateRegistry &registry, StateID id,
+        std::shared_ptr<const std::vector<PackedStateBin>> &&buffer) const {
+        return State(*task, registry, id, std::move(buffer));
+    }
+
     State get_initial_state() const {
         return create_state(task->get_initial_state_values());
     }
@@ -4,21 +4,58 @@
 #include "successor_generator_internals.h"
 
 #include "../abstract_task.h"
+#include "../state_registry.h"
+
+#include "../plugins/plugin.h"
+#include "../utils/memory.h"
 
 using namespace std;
 
 namespace successor_generator {
-SuccessorGenerator::SuccessorGenerator(const TaskProxy &task_proxy)
-    : root(SuccessorGeneratorFactory(task_proxy).create()) {
+static GeneratorPtr create_generator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type) {
+    SuccessorGeneratorFactory factory(task_proxy);
+    if (type == SuccessorGeneratorType::COMPILED) {
+        return factory.create_compiled();
+    } else {
+        return factory.create();
+    }
+}
+
+SuccessorGenerator::SuccessorGenerator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type)
+    : root(create_generator(task_proxy, type)) {
 }
 
 SuccessorGenerator::~SuccessorGenerator() = default;
 
 void SuccessorGenerator::generate_applicable_ops(
     const State &state, vector<OperatorID> &applicable_ops) const {
-    state.unpack();
-    root->generate_applicable_ops(state.get_unpacked_values(), applicable_ops);
+    const StateRegistry *registry = state.get_registry();
+    if (registry) {
+        /*
+          Registered states have packed data, which we read directly to
+          avoid allocating and filling the unpacked values of the state.
+        */
+        PackedStateView packed_state(
+            state.get_buffer(), registry->get_state_packer());
+        root->generate_applicable_ops(packed_state, applicable_ops);
+    } else {
+        // Unregistered states always have unpacked values.
+        root->generate_applicable_ops(state.get_unpacked_values(), applicable_ops);
+    }
 }
 
 PerTaskInformation<SuccessorGenerator> g_successor_generators;
+PerTaskInformation<SuccessorGenerator> g_compiled_successor_generators(
+    [](const TaskProxy &task_proxy) {
+        return utils::make_unique_ptr<SuccessorGenerator>(
+            task_proxy, SuccessorGeneratorType::COMPILED);
+    });
+
+static plugins::TypedEnumPlugin<SuccessorGeneratorType> _enum_plugin({
+    {"tree", "decision tree with one object per node"},
+    {"compiled", "the same decision tree stored as a flat byte code "
+     "that is evaluated without virtual calls"}
+});
 }
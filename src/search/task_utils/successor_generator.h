@@ -13,11 +13,18 @@ class TaskProxy;
 namespace successor_generator {
 class GeneratorBase;
 
+enum class SuccessorGeneratorType {
+    TREE,
+    COMPILED
+};
+
 class SuccessorGenerator {
     std::unique_ptr<GeneratorBase> root;
 
 public:
-    explicit SuccessorGenerator(const TaskProxy &task_proxy);
+    explicit SuccessorGenerator(
+        const TaskProxy &task_proxy,
+        SuccessorGeneratorType type = SuccessorGeneratorType::TREE);
     /*
       We cannot use the default destructor (implicitly or explicitly)
       here because GeneratorBase is a forward declaration and the
@@ -30,6 +37,7 @@ public:
 };
 
 extern PerTaskInformation<SuccessorGenerator> g_successor_generators;
+extern PerTaskInformation<SuccessorGenerator> g_compiled_successor_generators;
 }
 
 #endif
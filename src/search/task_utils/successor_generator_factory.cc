@@ -296,4 +296,9 @@ GeneratorPtr SuccessorGeneratorFactory::create() {
     operator_infos.clear();
     return root;
 }
+
+GeneratorPtr SuccessorGeneratorFactory::create_compiled() {
+    GeneratorPtr root = create();
+    return utils::make_unique_ptr<GeneratorCompiled>(*root);
+}
 }
@@ -31,6 +31,8 @@ public:
     // Destructor cannot be implicit because OperatorInfo is forward-declared.
     ~SuccessorGeneratorFactory();
     GeneratorPtr create();
+    // Create the generator tree and compile it (see GeneratorCompiled).
+    GeneratorPtr create_compiled();
 };
 }
 
@@ -2,6 +2,9 @@
 
 #include "../task_proxy.h"
 
+#include "../utils/system.h"
+
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -21,7 +24,8 @@ using namespace std;
   - Going further down this route, on the more extreme end of the
     spectrum, we could use a "byte-code" style representation, where
     the successor generator is just a long vector of ints combining
-    information about node type with node payload.
+    information about node type with node payload. (GeneratorCompiled
+    implements a variant of this as an alternative to the tree.)
 
     For example, we could represent different node types as follows,
     where BINARY_FORK etc. are symbolic constants for tagging node
@@ -68,6 +72,19 @@ using namespace std;
 */
 
 namespace successor_generator {
+static int compile_fork(
+    const vector<const GeneratorBase *> &children, vector<int> &code) {
+    int pos = code.size();
+    code.push_back(GeneratorCompiled::FORK);
+    code.push_back(children.size());
+    code.resize(code.size() + children.size(), GeneratorCompiled::NO_CHILD);
+    for (size_t i = 0; i < children.size(); ++i) {
+        int child_pos = children[i]->compile(code);
+        code[pos + 2 + i] = child_pos - pos;
+    }
+    return pos;
+}
+
 GeneratorForkBinary::GeneratorForkBinary(
     unique_ptr<GeneratorBase> generator1,
     unique_ptr<GeneratorBase> generator2)
@@ -86,6 +103,16 @@ void GeneratorForkBinary::generate_applicable_ops(
     generator2->generate_applicable_ops(state, applicable_ops);
 }
 
+void GeneratorForkBinary::generate_applicable_ops(
+    const PackedStateView &state, vector<OperatorID> &applicable_ops) const {
+    generator1->generate_applicable_ops(state, applicable_ops);
+    generator2->generate_applicable_ops(state, applicable_ops);
+}
+
+int GeneratorForkBinary::compile(vector<int> &code) const {
+    return compile_fork({generator1.get(), generator2.get()}, code);
+}
+
 GeneratorForkMulti::GeneratorForkMulti(vector<unique_ptr<GeneratorBase>> children)
     : children(move(children)) {
     /* Note that we permit 0-ary forks as a way to define empty
@@ -101,14 +128,29 @@ void GeneratorForkMulti::generate_applicable_ops(
         generator->generate_applicable_ops(state, applicable_ops);
 }
 
+void GeneratorForkMulti::generate_applicable_ops(
+    const PackedStateView &state, vector<OperatorID> &applicable_ops) const {
+    for (const auto &generator : children)
+        generator->generate_applicable_ops(state, applicable_ops);
+}
+
+int GeneratorForkMulti::compile(vector<int> &code) const {
+    vector<const GeneratorBase *> child_generators;
+    child_generators.reserve(children.size());
+    for (const auto &generator : children)
+        child_generators.push_back(generator.get());
+    return compile_fork(child_generators, code);
+}
+
 GeneratorSwitchVector::GeneratorSwitchVector(
     int switch_var_id, vector<unique_ptr<GeneratorBase>> &&generator_for_value)
     : switch_var_id(switch_var_id),
       generator_for_value(move(generator_for_value)) {
 }
 
-void GeneratorSwitchVector::generate_applicable_ops(
-    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+template<typename StateView>
+void GeneratorSwitchVector::generate(
+    const StateView &state, vector<OperatorID> &applicable_ops) const {
     int val = state[switch_var_id];
     const unique_ptr<GeneratorBase> &generator_for_val = generator_for_value[val];
     if (generator_for_val) {
@@ -116,6 +158,31 @@ void GeneratorSwitchVector::generate_applicable_ops(
     }
 }
 
+void GeneratorSwitchVector::generate_applicable_ops(
+    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+    generate(state, applicable_ops);
+}
+
+void GeneratorSwitchVector::generate_applicable_ops(
+    const PackedStateView &state, vector<OperatorID> &applicable_ops) const {
+    generate(state, applicable_ops);
+}
+
+int GeneratorSwitchVector::compile(vector<int> &code) const {
+    int pos = code.size();
+    code.push_back(GeneratorCompiled::SWITCH_VECTOR);
+    code.push_back(switch_var_id);
+    code.resize(code.size() + generator_for_value.size(),
+                GeneratorCompiled::NO_CHILD);
+    for (size_t value = 0; value < generator_for_value.size(); ++value) {
+        if (generator_for_value[value]) {
+            int child_pos = generator_for_value[value]->compile(code);
+            code[pos + 2 + value] = child_pos - pos;
+        }
+    }
+    return pos;
+}
+
 GeneratorSwitchHash::GeneratorSwitchHash(
     int switch_var_id,
     unordered_map<int, unique_ptr<GeneratorBase>> &&generator_for_value)
@@ -123,8 +190,9 @@ GeneratorSwitchHash::GeneratorSwitchHash(
       generator_for_value(move(generator_for_value)) {
 }
 
-void GeneratorSwitchHash::generate_applicable_ops(
-    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+template<typename StateView>
+void GeneratorSwitchHash::generate(
+    const StateView &state, vector<OperatorID> &applicable_ops) const {
     int val = state[switch_var_id];
     const auto &child = generator_for_value.find(val);
     if (child != generator_for_value.end()) {
@@ -133,6 +201,37 @@ void GeneratorSwitchHash::generate_applicable_ops(
     }
 }
 
+void GeneratorSwitchHash::generate_applicable_ops(
+    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+    generate(state, applicable_ops);
+}
+
+void GeneratorSwitchHash::generate_applicable_ops(
+    const PackedStateView &state, vector<OperatorID> &applicable_ops) const {
+    generate(state, applicable_ops);
+}
+
+int GeneratorSwitchHash::compile(vector<int> &code) const {
+    vector<int> values;
+    values.reserve(generator_for_value.size());
+    for (const auto &entry : generator_for_value)
+        values.push_back(entry.first);
+    sort(values.begin(), values.end());
+    int num_children = values.size();
+
+    int pos = code.size();
+    code.push_back(GeneratorCompiled::SWITCH_SORTED);
+    code.push_back(switch_var_id);
+    code.push_back(num_children);
+    code.insert(code.end(), values.begin(), values.end());
+    code.resize(code.size() + num_children, GeneratorCompiled::NO_CHILD);
+    for (int i = 0; i < num_children; ++i) {
+        int child_pos = generator_for_value.at(values[i])->compile(code);
+        code[pos + 3 + num_children + i] = child_pos - pos;
+    }
+    return pos;
+}
+
 GeneratorSwitchSingle::GeneratorSwitchSingle(
     int switch_var_id, int value, unique_ptr<GeneratorBase> generator_for_value)
     : switch_var_id(switch_var_id),
@@ -140,13 +239,35 @@ GeneratorSwitchSingle::GeneratorSwitchSingle(
       generator_for_value(move(generator_for_value)) {
 }
 
-void GeneratorSwitchSingle::generate_applicable_ops(
-    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+template<typename StateView>
+void GeneratorSwitchSingle::generate(
+    const StateView &state, vector<OperatorID> &applicable_ops) const {
     if (value == state[switch_var_id]) {
         generator_for_value->generate_applicable_ops(state, applicable_ops);
     }
 }
 
+void GeneratorSwitchSingle::generate_applicable_ops(
+    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+    generate(state, applicable_ops);
+}
+
+void GeneratorSwitchSingle::generate_applicable_ops(
+    const PackedStateView &state, vector<OperatorID> &applicable_ops) const {
+    generate(state, applicable_ops);
+}
+
+int GeneratorSwitchSingle::compile(vector<int> &code) const {
+    int pos = code.size();
+    code.push_back(GeneratorCompiled::SWITCH_SINGLE);
+    code.push_back(switch_var_id);
+    code.push_back(value);
+    code.push_back(GeneratorCompiled::NO_CHILD);
+    int child_pos = generator_for_value->compile(code);
+    code[pos + 3] = child_pos - pos;
+    return pos;
+}
+
 GeneratorLeafVector::GeneratorLeafVector(vector<OperatorID> &&applicable_operators)
     : applicable_operators(move(applicable_operators)) {
 }
@@ -165,6 +286,23 @@ void GeneratorLeafVector::generate_applicable_ops(
     }
 }
 
+void GeneratorLeafVector::generate_applicable_ops(
+    const PackedStateView &, vector<OperatorID> &applicable_ops) const {
+    for (OperatorID id : applicable_operators) {
+        applicable_ops.push_back(id);
+    }
+}
+
+int GeneratorLeafVector::compile(vector<int> &code) const {
+    int pos = code.size();
+    code.push_back(GeneratorCompiled::LEAF);
+    code.push_back(applicable_operators.size());
+    for (OperatorID id : applicable_operators) {
+        code.push_back(id.get_index());
+    }
+    return pos;
+}
+
 GeneratorLeafSingle::GeneratorLeafSingle(OperatorID applicable_operator)
     : applicable_operator(applicable_operator) {
 }
@@ -173,4 +311,97 @@ void GeneratorLeafSingle::generate_applicable_ops(
     const vector<int> &, vector<OperatorID> &applicable_ops) const {
     applicable_ops.push_back(applicable_operator);
 }
+
+void GeneratorLeafSingle::generate_applicable_ops(
+    const PackedStateView &, vector<OperatorID> &applicable_ops) const {
+    applicable_ops.push_back(applicable_operator);
+}
+
+int GeneratorLeafSingle::compile(vector<int> &code) const {
+    int pos = code.size();
+    code.push_back(GeneratorCompiled::LEAF);
+    code.push_back(1);
+    code.push_back(applicable_operator.get_index());
+    return pos;
+}
+
+GeneratorCompiled::GeneratorCompiled(const GeneratorBase &root) {
+    root.compile(code);
+    code.shrink_to_fit();
+}
+
+void GeneratorCompiled::generate_applicable_ops(
+    const vector<int> &state, vector<OperatorID> &applicable_ops) const {
+    generate(0, state, applicable_ops);
+}
+
+void GeneratorCompiled::generate_applicable_ops(
+    const PackedStateView &state, vector<OperatorID> &applicable_ops) const {
+    generate(0, state, applicable_ops);
+}
+
+template<typename StateView>
+void GeneratorCompiled::generate(
+    int pos, const StateView &state,
+    vector<OperatorID> &applicable_ops) const {
+    /*
+      We only recurse for the children of forks except the last one. For
+      all other nodes, we continue the loop with the (only) child. This
+      generates the operators in the same order as the tree.
+    */
+    while (true) {
+        const int *node = &code[pos];
+        switch (node[0]) {
+        case FORK: {
+            int num_children = node[1];
+            if (num_children == 0)
+                return;
+            for (int i = 0; i < num_children - 1; ++i) {
+                generate(pos + node[2 + i], state, applicable_ops);
+            }
+            pos += node[1 + num_children];
+            break;
+        }
+        case SWITCH_VECTOR: {
+            int child = node[2 + state[node[1]]];
+            if (child == NO_CHILD)
+                return;
+            pos += child;
+            break;
+        }
+        case SWITCH_SORTED: {
+            int val = state[node[1]];
+            int num_children = node[2];
+            const int *values_begin = node + 3;
+            const int *values_end = values_begin + num_children;
+            const int *it = lower_bound(values_begin, values_end, val);
+            if (it == values_end || *it != val)
+                return;
+            pos += values_end[it - values_begin];
+            break;
+        }
+        case SWITCH_SINGLE:
+            if (state[node[1]] != node[2])
+                return;
+            pos += node[3];
+            break;
+        case LEAF: {
+            int num_operators = node[1];
+            for (int i = 0; i < num_operators; ++i) {
+                applicable_ops.emplace_back(node[2 + i]);
+            }
+            return;
+        }
+        default:
+            ABORT("Unknown successor generator node type.");
+        }
+    }
+}
+
+int GeneratorCompiled::compile(vector<int> &code) const {
+    // The code is position-independent, so we can simply copy it.
+    int pos = code.size();
+    code.insert(code.end(), this->code.begin(), this->code.end());
+    return pos;
+}
 }
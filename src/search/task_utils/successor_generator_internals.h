@@ -3,6 +3,8 @@
 
 #include "../operator_id.h"
 
+#include "../algorithms/int_packer.h"
+
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -10,12 +12,40 @@
 class State;
 
 namespace successor_generator {
+/*
+  Read access to the values of a registered state through its packed
+  data. Generators can use it like the vector of unpacked values, which
+  allows computing the applicable operators without unpacking the state.
+*/
+class PackedStateView {
+    const int_packer::IntPacker::Bin *buffer;
+    const int_packer::IntPacker &state_packer;
+public:
+    PackedStateView(const int_packer::IntPacker::Bin *buffer,
+                    const int_packer::IntPacker &state_packer)
+        : buffer(buffer),
+          state_packer(state_packer) {
+    }
+
+    int operator[](int var) const {
+        return state_packer.get(buffer, var);
+    }
+};
+
 class GeneratorBase {
 public:
     virtual ~GeneratorBase() {}
 
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const = 0;
+    virtual void generate_applicable_ops(
+        const PackedStateView &state, std::vector<OperatorID> &applicable_ops) const = 0;
+
+    /*
+      Append the byte code of this node and its descendants (see
+      GeneratorCompiled) to code and return the position of the node.
+    */
+    virtual int compile(std::vector<int> &code) const = 0;
 };
 
 class GeneratorForkBinary : public GeneratorBase {
@@ -27,6 +57,9 @@ public:
         std::unique_ptr<GeneratorBase> generator2);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual void generate_applicable_ops(
+        const PackedStateView &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorForkMulti : public GeneratorBase {
@@ -35,40 +68,61 @@ public:
     GeneratorForkMulti(std::vector<std::unique_ptr<GeneratorBase>> children);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual void generate_applicable_ops(
+        const PackedStateView &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchVector : public GeneratorBase {
     int switch_var_id;
     std::vector<std::unique_ptr<GeneratorBase>> generator_for_value;
+
+    template<typename StateView>
+    void generate(const StateView &state, std::vector<OperatorID> &applicable_ops) const;
 public:
     GeneratorSwitchVector(
         int switch_var_id,
         std::vector<std::unique_ptr<GeneratorBase>> &&generator_for_value);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual void generate_applicable_ops(
+        const PackedStateView &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchHash : public GeneratorBase {
     int switch_var_id;
     std::unordered_map<int, std::unique_ptr<GeneratorBase>> generator_for_value;
+
+    template<typename StateView>
+    void generate(const StateView &state, std::vector<OperatorID> &applicable_ops) const;
 public:
     GeneratorSwitchHash(
         int switch_var_id,
         std::unordered_map<int, std::unique_ptr<GeneratorBase>> &&generator_for_value);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual void generate_applicable_ops(
+        const PackedStateView &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorSwitchSingle : public GeneratorBase {
     int switch_var_id;
     int value;
     std::unique_ptr<GeneratorBase> generator_for_value;
+
+    template<typename StateView>
+    void generate(const StateView &state, std::vector<OperatorID> &applicable_ops) const;
 public:
     GeneratorSwitchSingle(
         int switch_var_id, int value,
         std::unique_ptr<GeneratorBase> generator_for_value);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual void generate_applicable_ops(
+        const PackedStateView &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorLeafVector : public GeneratorBase {
@@ -77,6 +131,9 @@ public:
     GeneratorLeafVector(std::vector<OperatorID> &&applicable_operators);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual void generate_applicable_ops(
+        const PackedStateView &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 
 class GeneratorLeafSingle : public GeneratorBase {
@@ -85,6 +142,53 @@ public:
     GeneratorLeafSingle(OperatorID applicable_operator);
     virtual void generate_applicable_ops(
         const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual void generate_applicable_ops(
+        const PackedStateView &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
+};
+
+/*
+  Flat representation of a successor generator tree. All nodes are
+  stored as a "byte code" in a single vector<int> and are evaluated
+  by a loop without virtual calls. Each node starts with a tag for its
+  type, followed by its payload:
+
+  - fork:          [FORK, n, child_1, ..., child_n]
+  - vector switch: [SWITCH_VECTOR, var, child_0, ..., child_k]
+                   with one child for each value of var
+  - sorted switch: [SWITCH_SORTED, var, n, value_1, ..., value_n,
+                    child_1, ..., child_n]
+                   with values in increasing order (for binary search)
+  - single switch: [SWITCH_SINGLE, var, value, child]
+  - leaf:          [LEAF, n, op_1, ..., op_n]
+
+  Children are stored as offsets relative to the start of their parent.
+  Children always follow their parent, so NO_CHILD = 0 can mark values
+  of vector switches without child, and the code of a subtree does not
+  depend on its position.
+*/
+class GeneratorCompiled : public GeneratorBase {
+    std::vector<int> code;
+
+    template<typename StateView>
+    void generate(int pos, const StateView &state,
+                  std::vector<OperatorID> &applicable_ops) const;
+public:
+    enum NodeType {
+        FORK,
+        SWITCH_VECTOR,
+        SWITCH_SORTED,
+        SWITCH_SINGLE,
+        LEAF
+    };
+    static const int NO_CHILD = 0;
+
+    explicit GeneratorCompiled(const GeneratorBase &root);
+    virtual void generate_applicable_ops(
+        const std::vector<int> &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual void generate_applicable_ops(
+        const PackedStateView &state, std::vector<OperatorID> &applicable_ops) const override;
+    virtual int compile(std::vector<int> &code) const override;
 };
 }
 
@@ -0,0 +1,68 @@
+#include "memory_mapped_file.h"
+
+#include "system.h"
+
+#include <fstream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+MemoryMappedFile::MemoryMappedFile()
+    : mapping(nullptr),
+      size(0) {
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    if (mapping) {
+        munmap(mapping, size);
+    }
+#endif
+}
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+unique_ptr<MemoryMappedFile> MemoryMappedFile::open(const string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return nullptr;
+    struct stat file_status;
+    if (fstat(fd, &file_status) == -1 || file_status.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+    size_t size = file_status.st_size;
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after closing the file descriptor.
+    close(fd);
+    if (mapping == MAP_FAILED)
+        return nullptr;
+    unique_ptr<MemoryMappedFile> file(new MemoryMappedFile());
+    file->mapping = mapping;
+    file->size = size;
+    return file;
+}
+#else
+unique_ptr<MemoryMappedFile> MemoryMappedFile::open(const string &path) {
+    ifstream stream(path, ios::binary | ios::ate);
+    if (!stream)
+        return nullptr;
+    size_t size = stream.tellg();
+    if (size == 0)
+        return nullptr;
+    unique_ptr<MemoryMappedFile> file(new MemoryMappedFile());
+    file->contents.resize(size);
+    stream.seekg(0);
+    if (!stream.read(file->contents.data(), size))
+        return nullptr;
+    file->size = size;
+    return file;
+}
+#endif
+}
@@ -0,0 +1,40 @@
+#ifndef UTILS_MEMORY_MAPPED_FILE_H
+#define UTILS_MEMORY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace utils {
+/*
+  Read-only access to the contents of a file. On Unix systems, the file
+  is mapped into memory, so that its pages are only loaded on access and
+  are shared between all processes that map the same file. On other
+  systems, the file is read into memory.
+*/
+class MemoryMappedFile {
+    void *mapping;
+    std::size_t size;
+    std::vector<char> contents;
+
+    MemoryMappedFile();
+public:
+    ~MemoryMappedFile();
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    // Return nullptr if the file cannot be opened or is empty.
+    static std::unique_ptr<MemoryMappedFile> open(const std::string &path);
+
+    const char *get_data() const {
+        return mapping ? static_cast<const char *>(mapping) : contents.data();
+    }
+
+    std::size_t get_size() const {
+        return size;
+    }
+};
+}
+
+#endif
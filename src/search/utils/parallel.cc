@@ -0,0 +1,41 @@
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace utils {
+// True while the current thread runs items of a parallel loop.
+static thread_local bool in_parallel_loop = false;
+
+void parallel_for(
+    int num_items, int num_threads, const function<void(int)> &function) {
+    num_threads = min(num_threads, num_items);
+    if (num_threads <= 1 || in_parallel_loop) {
+        for (int i = 0; i < num_items; ++i) {
+            function(i);
+        }
+        return;
+    }
+    atomic<int> next_item(0);
+    auto run = [&]() {
+            in_parallel_loop = true;
+            for (int i = next_item++; i < num_items; i = next_item++) {
+                function(i);
+            }
+            in_parallel_loop = false;
+        };
+    vector<thread> helpers;
+    helpers.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; ++i) {
+        helpers.emplace_back(run);
+    }
+    run();
+    for (thread &helper : helpers) {
+        helper.join();
+    }
+}
+}
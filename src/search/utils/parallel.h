@@ -0,0 +1,23 @@
+#ifndef UTILS_PARALLEL_H
+#define UTILS_PARALLEL_H
+
+#include <functional>
+
+namespace utils {
+/*
+  Call function(i) for all i in {0, ..., num_items - 1}, using up to
+  num_threads threads including the calling thread. Items are assigned
+  to threads dynamically, so calls happen in no particular order and
+  must be independent of each other. For deterministic results, call
+  i should only write to data owned by item i.
+
+  Calls of parallel_for from within function run sequentially, so that
+  nested parallel loops (e.g., a shrink strategy with threads used by a
+  merge scoring function with threads) never use more than num_threads
+  threads of the outermost loop.
+*/
+extern void parallel_for(
+    int num_items, int num_threads, const std::function<void(int)> &function);
+}
+
+#endif